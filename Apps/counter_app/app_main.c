@@ -14,7 +14,7 @@ static const app_manifest_t counter_manifest = {
     .description = "Simple counter app",
     .icon = "counter.png",
     .type = APP_TYPE_INTERNAL,
-    .stack_size = 4096,
+    .stack_size = 0, // Auto-sized from measured peak use
     .priority = 5,
     .requires_gui = true,
     .requires_sdcard = false,
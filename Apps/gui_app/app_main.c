@@ -13,7 +13,7 @@ static const app_manifest_t gui_test_app_manifest = {
     .description = "A test app demonstrating GUI features.",
     .icon = "input.png",
     .type = APP_TYPE_INTERNAL,
-    .stack_size = 4096,
+    .stack_size = 0, // Auto-sized from measured peak use
     .priority = 5,
     .requires_sdcard = false,
     .requires_network = false};
@@ -19,7 +19,7 @@ static const app_manifest_t counter_manifest = {
     .description = "Reads ADC values from GPIO4",
     .icon = "adc_reader.png",
     .type = APP_TYPE_INTERNAL,
-    .stack_size = 4096,
+    .stack_size = 0, // Auto-sized from measured peak use
     .priority = 5,
     .requires_gui = true,
     .requires_sdcard = false,
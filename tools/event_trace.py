@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+"""
+uFlake Event Trace Tool
+=======================
+
+Reads a UFET recording produced by uflake_event_trace_export_file() /
+uflake_event_trace_export_uart() and:
+
+1. report  - publish->dispatch latency per event, callback time per subscriber
+2. replay  - re-runs the recorded publish stream through a model of the
+             kernel dispatcher (one FIFO queue of MAX_PENDING_EVENTS, measured
+             callback costs) to reproduce event storms offline, and can write
+             the stream as a replay script for a host build of event_manager
+
+UART captures may contain console log text around the dump; the tool scans
+for the UFET magic and ignores everything before it.
+
+Usage:
+    python event_trace.py report events.uft
+    python event_trace.py report events.uft --top 20
+    python event_trace.py replay events.uft --speed 4 --script storm.replay
+"""
+
+import argparse
+import struct
+import sys
+from collections import defaultdict, deque
+
+MAGIC = 0x54454655  # "UFET"
+HEADER = struct.Struct('<IHHHHII')
+RECORD = struct.Struct('<IIHBBHH')
+
+KIND_PUBLISH = 0
+KIND_PUBLISH_ISR = 1
+KIND_DISPATCH = 2
+KIND_CB_START = 3
+KIND_CB_END = 4
+KIND_DROP = 5
+
+KIND_NAMES = ['publish', 'publish_isr', 'dispatch', 'cb_start', 'cb_end', 'drop']
+
+FLAG_POLICED = 0x01
+FLAG_BUFFER = 0x02
+
+MAX_PENDING_EVENTS = 50  # Must match event_manager.c
+
+
+def load_trace(path):
+    """Parse a UFET file into (names, records, lost_count)"""
+    with open(path, 'rb') as f:
+        blob = f.read()
+
+    offset = blob.find(struct.pack('<I', MAGIC))
+    if offset < 0:
+        raise ValueError(f'{path}: no UFET magic found')
+
+    magic, version, record_size, name_count, _, record_count, lost = HEADER.unpack_from(blob, offset)
+    if version != 1 or record_size != RECORD.size:
+        raise ValueError(f'{path}: unsupported trace version {version} / record size {record_size}')
+    offset += HEADER.size
+
+    names = []
+    for _ in range(name_count):
+        length = blob[offset]
+        names.append(blob[offset + 1:offset + 1 + length].decode('utf-8', 'replace'))
+        offset += 1 + length
+
+    records = []
+    last_raw = None
+    wraps = 0
+    for i in range(record_count):
+        ts, sub_id, name_id, kind, flags, size, pid = RECORD.unpack_from(blob, offset + i * RECORD.size)
+        # Timestamps are the low 32 bits of esp_timer - unwrap (71 min period)
+        if last_raw is not None and ts < last_raw and last_raw - ts > 0x80000000:
+            wraps += 1
+        last_raw = ts
+        name = names[name_id] if name_id < len(names) else f'<name#{name_id}>'
+        records.append({
+            't': ts + (wraps << 32),
+            'kind': kind,
+            'name': name,
+            'flags': flags,
+            'size': size,
+            'sub': sub_id,
+            'pid': pid,
+        })
+
+    # Records from different cores can interleave slightly out of order
+    records.sort(key=lambda r: r['t'])
+    return names, records, lost
+
+
+def percentile(values, pct):
+    if not values:
+        return 0
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, int(round(pct / 100.0 * (len(ordered) - 1))))
+    return ordered[index]
+
+
+def analyze(records):
+    """Match publishes to dispatches and callback starts to ends"""
+    pending = defaultdict(deque)         # name -> publish timestamps
+    latency = defaultdict(list)          # name -> publish->dispatch us
+    merged = defaultdict(int)            # name -> publishes folded by a policy
+    drops = defaultdict(int)
+    cb_open = {}                         # sub id -> start us
+    cb_time = defaultdict(list)          # (sub id, pid, name) -> callback us
+    published = defaultdict(int)
+
+    for rec in records:
+        kind, name = rec['kind'], rec['name']
+        if kind in (KIND_PUBLISH, KIND_PUBLISH_ISR):
+            published[name] += 1
+            pending[name].append((rec['t'], rec['flags']))
+        elif kind == KIND_DISPATCH:
+            queue = pending[name]
+            if not queue:
+                continue
+            if rec['flags'] & FLAG_POLICED or queue[-1][1] & FLAG_POLICED:
+                # Policy slot holds only the latest payload
+                latency[name].append(rec['t'] - queue[-1][0])
+                merged[name] += len(queue) - 1
+                queue.clear()
+            else:
+                latency[name].append(rec['t'] - queue.popleft()[0])
+        elif kind == KIND_CB_START:
+            cb_open[rec['sub']] = rec['t']
+        elif kind == KIND_CB_END:
+            start = cb_open.pop(rec['sub'], None)
+            if start is not None:
+                cb_time[(rec['sub'], rec['pid'], name)].append(rec['t'] - start)
+        elif kind == KIND_DROP:
+            drops[name] += 1
+            if pending[name]:
+                pending[name].pop()
+
+    return published, latency, merged, drops, cb_time
+
+
+def cmd_report(args):
+    names, records, lost = load_trace(args.trace)
+    if not records:
+        print('Trace is empty')
+        return 0
+
+    span_us = records[-1]['t'] - records[0]['t']
+    print(f'{len(records)} records, {len(names)} event names, {span_us / 1e6:.3f} s span, {lost} records lost to ring wrap')
+
+    published, latency, merged, drops, cb_time = analyze(records)
+
+    print('\n=== Publish -> dispatch latency (us) ===')
+    print(f'{"event":<32} {"count":>7} {"rate/s":>8} {"p50":>8} {"p95":>8} {"max":>8} {"merged":>7} {"drops":>6}')
+    for name in sorted(published, key=lambda n: -percentile(latency[n], 95)):
+        lat = latency[name]
+        rate = published[name] / (span_us / 1e6) if span_us else 0
+        print(f'{name:<32} {published[name]:>7} {rate:>8.1f} {percentile(lat, 50):>8} '
+              f'{percentile(lat, 95):>8} {max(lat) if lat else 0:>8} {merged[name]:>7} {drops[name]:>6}')
+
+    print('\n=== Subscriber callback time (us), slowest first ===')
+    print(f'{"sub":>5} {"pid":>5} {"event":<32} {"calls":>7} {"p50":>8} {"p95":>8} {"max":>8} {"total":>10}')
+    rows = sorted(cb_time.items(), key=lambda kv: -sum(kv[1]))
+    for (sub, pid, name), times in rows[:args.top]:
+        print(f'{sub:>5} {pid:>5} {name:<32} {len(times):>7} {percentile(times, 50):>8} '
+              f'{percentile(times, 95):>8} {max(times):>8} {sum(times):>10}')
+    return 0
+
+
+def cmd_replay(args):
+    names, records, _ = load_trace(args.trace)
+    publishes = [r for r in records if r['kind'] in (KIND_PUBLISH, KIND_PUBLISH_ISR)]
+    if not publishes:
+        print('No publishes in trace')
+        return 0
+
+    _, _, _, _, cb_time = analyze(records)
+
+    # Per-event dispatch cost = sum of mean callback time of its subscribers
+    cost = defaultdict(float)
+    for (_, _, name), times in cb_time.items():
+        cost[name] += sum(times) / len(times)
+
+    t0 = publishes[0]['t']
+    if args.script:
+        with open(args.script, 'w') as out:
+            out.write('# ufet-replay v1: <t_us> <publish|publish_isr> <name> <data_size> <flags>\n')
+            for rec in publishes:
+                t = int((rec['t'] - t0) / args.speed)
+                out.write(f'{t} {KIND_NAMES[rec["kind"]]} {rec["name"]} {rec["size"]} {rec["flags"]}\n')
+        print(f'Wrote {len(publishes)} publishes to {args.script}')
+
+    # Single FIFO dispatcher model; policed events never occupy the queue
+    queue = deque()
+    busy_until = 0.0
+    peak_depth = 0
+    overflows = 0
+    worst_wait = 0.0
+    for rec in publishes:
+        now = (rec['t'] - t0) / args.speed
+        while queue and busy_until <= now:
+            start = max(busy_until, queue[0][0])
+            worst_wait = max(worst_wait, start - queue[0][0])
+            busy_until = start + cost[queue[0][1]]
+            queue.popleft()
+        if rec['flags'] & FLAG_POLICED:
+            continue
+        if len(queue) >= MAX_PENDING_EVENTS:
+            overflows += 1
+            continue
+        queue.append((now, rec['name']))
+        if busy_until < now:
+            busy_until = now
+        peak_depth = max(peak_depth, len(queue))
+
+    print(f'Replayed {len(publishes)} publishes at {args.speed}x speed')
+    print(f'Peak queue depth: {peak_depth}/{MAX_PENDING_EVENTS}')
+    print(f'Queue-full publishes (would block up to 100 ms): {overflows}')
+    print(f'Worst queueing delay: {worst_wait:.0f} us')
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Analyze and replay uFlake event traces')
+    sub = parser.add_subparsers(dest='command', required=True)
+
+    report = sub.add_parser('report', help='Latency and slow-subscriber report')
+    report.add_argument('trace', help='UFET file (SD export or raw UART capture)')
+    report.add_argument('--top', type=int, default=10, help='Subscriber rows to show')
+    report.set_defaults(func=cmd_report)
+
+    replay = sub.add_parser('replay', help='Replay the publish stream through a dispatcher model')
+    replay.add_argument('trace', help='UFET file (SD export or raw UART capture)')
+    replay.add_argument('--speed', type=float, default=1.0, help='Time compression factor (2 = twice as fast)')
+    replay.add_argument('--script', help='Also write the stream as a replay script for a host build')
+    replay.set_defaults(func=cmd_replay)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,374 @@
+#!/usr/bin/env python3
+"""
+uFlake Kernel Trace Tool
+========================
+
+Reads a UFKT recording produced by uflake_kernel_trace_export_file() /
+uflake_kernel_trace_export_uart() and:
+
+1. json    - converts it to Chrome trace JSON, to be opened in
+             chrome://tracing or https://ui.perfetto.dev
+2. summary - prints CPU time per task and core, and record counts per kind
+
+Each core records with its own cycle counter. Every few ticks both cores
+write a SYNC record carrying esp_timer time, which is used to put the two
+cores on the common esp_timer clock (microseconds since boot).
+
+UART captures may contain console log text around the dump; the tool scans
+for the UFKT magic and ignores everything before it.
+
+Usage:
+    python kernel_trace.py json kernel.ufk -o kernel.json
+    python kernel_trace.py summary kernel.ufk
+"""
+
+import argparse
+import bisect
+import json
+import struct
+import sys
+from collections import defaultdict
+
+MAGIC = 0x544B4655  # "UFKT"
+HEADER = struct.Struct('<IHHHHHH')
+CORE_HEADER = struct.Struct('<II')
+RECORD = struct.Struct('<IBBHII')
+
+NO_LABEL = 0xFFFF
+FLAG_ISR = 0x01
+
+KIND_SYNC = 0
+KIND_TASK_SWITCH = 1
+KIND_MUTEX_WAIT = 2
+KIND_MUTEX_ACQUIRE = 3
+KIND_MUTEX_RELEASE = 4
+KIND_QUEUE_SEND = 5
+KIND_QUEUE_RECEIVE = 6
+KIND_TIMER_BEGIN = 7
+KIND_TIMER_END = 8
+KIND_EVENT_BEGIN = 9
+KIND_EVENT_END = 10
+KIND_SPI_BEGIN = 11
+KIND_SPI_END = 12
+KIND_FLUSH_BEGIN = 13
+KIND_FLUSH_END = 14
+KIND_MARK = 15
+
+KIND_NAMES = ['sync', 'task_switch', 'mutex_wait', 'mutex_acquire', 'mutex_release',
+              'queue_send', 'queue_receive', 'timer_begin', 'timer_end', 'event_begin',
+              'event_end', 'spi_begin', 'spi_end', 'flush_begin', 'flush_end', 'mark']
+
+# BEGIN kind -> (END kind, category)
+SLICES = {
+    KIND_TIMER_BEGIN: (KIND_TIMER_END, 'timer'),
+    KIND_EVENT_BEGIN: (KIND_EVENT_END, 'event'),
+    KIND_SPI_BEGIN: (KIND_SPI_END, 'spi'),
+    KIND_FLUSH_BEGIN: (KIND_FLUSH_END, 'gui'),
+}
+SLICE_ENDS = {end: begin for begin, (end, _) in SLICES.items()}
+
+PID_CPUS = 0
+PID_TASKS = 1
+TID_ISR_BASE = 100  # ISR track of core n in the CPU process
+
+
+def load_trace(path):
+    """Parse a UFKT file into a dict with labels, tasks, cpu_mhz and per-core records"""
+    with open(path, 'rb') as f:
+        blob = f.read()
+
+    offset = blob.find(struct.pack('<I', MAGIC))
+    if offset < 0:
+        raise ValueError(f'{path}: no UFKT magic found')
+
+    _, version, record_size, core_count, label_count, task_count, cpu_mhz = HEADER.unpack_from(blob, offset)
+    if version != 1 or record_size != RECORD.size:
+        raise ValueError(f'{path}: unsupported trace version {version} / record size {record_size}')
+    offset += HEADER.size
+
+    core_headers = []
+    for _ in range(core_count):
+        core_headers.append(CORE_HEADER.unpack_from(blob, offset))
+        offset += CORE_HEADER.size
+
+    def read_name(pos):
+        length = blob[pos]
+        return blob[pos + 1:pos + 1 + length].decode('utf-8', 'replace'), pos + 1 + length
+
+    labels = []
+    for _ in range(label_count):
+        name, offset = read_name(offset)
+        labels.append(name)
+
+    tasks = {}
+    for _ in range(task_count):
+        (handle,) = struct.unpack_from('<I', blob, offset)
+        name, offset = read_name(offset + 4)
+        tasks[handle] = name
+
+    cores = []
+    for core, (record_count, lost) in enumerate(core_headers):
+        records = []
+        for i in range(record_count):
+            ccount, kind, flags, label_id, task, arg = RECORD.unpack_from(blob, offset + i * RECORD.size)
+            records.append({
+                'ccount': ccount,
+                'kind': kind,
+                'flags': flags,
+                'label': labels[label_id] if label_id < len(labels) else (
+                    '' if label_id == NO_LABEL else f'<label#{label_id}>'),
+                'task': task,
+                'arg': arg,
+            })
+        offset += record_count * RECORD.size
+        cores.append({'records': records, 'lost': lost})
+
+    return {'labels': labels, 'tasks': tasks, 'cpu_mhz': cpu_mhz or 240, 'cores': cores}
+
+
+def unwrap(values, bits=32):
+    """Unwrap a sequence of wrapping counters that only move forwards"""
+    mask = (1 << bits) - 1
+    out = []
+    total = 0
+    last = None
+    for value in values:
+        if last is not None:
+            total += (value - last) & mask
+        else:
+            total = value
+        last = value
+        out.append(total)
+    return out
+
+
+def assign_timestamps(trace):
+    """Put every record on the esp_timer clock (us since boot) as record['ts']"""
+    mhz = trace['cpu_mhz']
+
+    for core in trace['cores']:
+        records = core['records']
+        if not records:
+            continue
+
+        cycles = unwrap([r['ccount'] for r in records])
+        syncs = [(cycles[i], r['arg']) for i, r in enumerate(records) if r['kind'] == KIND_SYNC]
+        sync_cycles = [c for c, _ in syncs]
+        sync_us = unwrap([us for _, us in syncs])
+
+        for i, record in enumerate(records):
+            c = cycles[i]
+            if not syncs:
+                # No sync yet - relative to the first record of this core
+                record['ts'] = (c - cycles[0]) / mhz
+                continue
+
+            # Interpolate between the surrounding sync points, extrapolate at the ends
+            j = bisect.bisect_right(sync_cycles, c) - 1
+            j = max(0, min(j, len(syncs) - 2)) if len(syncs) > 1 else 0
+            if len(syncs) > 1 and sync_cycles[j + 1] > sync_cycles[j]:
+                rate = (sync_cycles[j + 1] - sync_cycles[j]) / max(1, sync_us[j + 1] - sync_us[j])
+            else:
+                rate = mhz
+            record['ts'] = sync_us[j] + (c - sync_cycles[j]) / rate
+
+    # Start the timeline at the earliest record
+    start = min((r['ts'] for core in trace['cores'] for r in core['records']), default=0)
+    for core in trace['cores']:
+        for record in core['records']:
+            record['ts'] -= start
+
+
+def task_name(trace, handle):
+    if handle == 0:
+        return '<none>'
+    return trace['tasks'].get(handle, f'task 0x{handle:08x}')
+
+
+def build_chrome_trace(trace):
+    events = []
+    task_handles = set()
+    end_ts = max((r['ts'] for core in trace['cores'] for r in core['records']), default=0)
+
+    def meta(pid, tid, kind, name):
+        event = {'ph': 'M', 'pid': pid, 'name': kind, 'args': {'name': name}}
+        if tid is not None:
+            event['tid'] = tid
+        events.append(event)
+
+    meta(PID_CPUS, None, 'process_name', 'CPUs')
+    meta(PID_TASKS, None, 'process_name', 'Tasks')
+
+    for core_index, core in enumerate(trace['cores']):
+        meta(PID_CPUS, core_index, 'thread_name', f'CPU {core_index}')
+        meta(PID_CPUS, TID_ISR_BASE + core_index, 'thread_name', f'CPU {core_index} ISR')
+
+        records = core['records']
+        running = None  # (task, start ts)
+        open_slices = defaultdict(list)  # (track, begin kind) -> [start records]
+
+        for record in records:
+            kind = record['kind']
+            ts = record['ts']
+            isr = record['flags'] & FLAG_ISR
+            if isr:
+                pid, tid = PID_CPUS, TID_ISR_BASE + core_index
+            else:
+                pid, tid = PID_TASKS, record['task']
+                task_handles.add(record['task'])
+
+            if kind == KIND_TASK_SWITCH:
+                if running:
+                    events.append(running_slice(trace, core_index, running[0], running[1], ts))
+                running = (record['task'], ts)
+                task_handles.add(record['task'])
+
+            elif kind in SLICES:
+                open_slices[(pid, tid, kind)].append(record)
+
+            elif kind in SLICE_ENDS:
+                begin_kind = SLICE_ENDS[kind]
+                stack = open_slices[(pid, tid, begin_kind)]
+                if not stack:
+                    continue  # Began before the ring's oldest record
+                begin = stack.pop()
+                events.append({
+                    'ph': 'X', 'pid': pid, 'tid': tid, 'ts': begin['ts'], 'dur': max(0.0, ts - begin['ts']),
+                    'name': begin['label'] or KIND_NAMES[begin_kind].rsplit('_', 1)[0],
+                    'cat': SLICES[begin_kind][1], 'args': {'arg': begin['arg'], 'core': core_index},
+                })
+
+            elif kind in (KIND_MUTEX_WAIT, KIND_MUTEX_ACQUIRE, KIND_MUTEX_RELEASE):
+                events.extend(mutex_events(record, pid, tid))
+
+            elif kind in (KIND_QUEUE_SEND, KIND_QUEUE_RECEIVE, KIND_MARK):
+                events.append({
+                    'ph': 'i', 's': 't', 'pid': pid, 'tid': tid, 'ts': ts,
+                    'name': f"{KIND_NAMES[kind]} {record['label']}".strip(),
+                    'cat': 'mark' if kind == KIND_MARK else 'queue',
+                    'args': {'arg': record['arg'], 'core': core_index},
+                })
+
+        if running:
+            events.append(running_slice(trace, core_index, running[0], running[1], end_ts))
+
+    for handle in sorted(task_handles):
+        meta(PID_TASKS, handle, 'thread_name', task_name(trace, handle))
+
+    return {'traceEvents': events, 'displayTimeUnit': 'ms'}
+
+
+def running_slice(trace, core, task, start, end):
+    return {
+        'ph': 'X', 'pid': PID_CPUS, 'tid': core, 'ts': start, 'dur': max(0.0, end - start),
+        'name': task_name(trace, task), 'cat': 'sched', 'args': {'task': f'0x{task:08x}'},
+    }
+
+
+# Mutex wait and hold are async slices keyed by mutex and task, so they may
+# overlap other slices on the task track
+_mutex_state = {}
+
+
+def mutex_events(record, pid, tid):
+    key = (record['arg'], record['task'])
+    label = record['label'] or 'mutex'
+    ident = f"0x{record['arg']:08x}:{record['task']:08x}"
+    state = _mutex_state.get(key)
+    out = []
+
+    def async_event(ph, name):
+        return {'ph': ph, 'pid': pid, 'tid': tid, 'ts': record['ts'], 'id': ident,
+                'name': name, 'cat': 'mutex', 'args': {'mutex': f"0x{record['arg']:08x}"}}
+
+    kind = record['kind']
+    if kind == KIND_MUTEX_WAIT:
+        out.append(async_event('b', f'wait {label}'))
+        _mutex_state[key] = 'wait'
+    elif kind == KIND_MUTEX_ACQUIRE:
+        if state == 'wait':
+            out.append(async_event('e', f'wait {label}'))
+        out.append(async_event('b', f'hold {label}'))
+        _mutex_state[key] = 'hold'
+    elif kind == KIND_MUTEX_RELEASE and state:
+        # Release ends the hold, or a wait that timed out
+        out.append(async_event('e', f'{state} {label}'))
+        _mutex_state.pop(key, None)
+
+    return out
+
+
+def cmd_json(args):
+    trace = load_trace(args.trace)
+    assign_timestamps(trace)
+    output = args.output or args.trace.rsplit('.', 1)[0] + '.json'
+
+    with open(output, 'w') as f:
+        json.dump(build_chrome_trace(trace), f)
+
+    for index, core in enumerate(trace['cores']):
+        if core['lost']:
+            print(f"CPU {index}: {core['lost']} older records were overwritten", file=sys.stderr)
+    print(f'Wrote {output} - open it in chrome://tracing or https://ui.perfetto.dev')
+    return 0
+
+
+def cmd_summary(args):
+    trace = load_trace(args.trace)
+    assign_timestamps(trace)
+
+    print(f"{len(trace['cores'])} cores @ {trace['cpu_mhz']} MHz, {len(trace['labels'])} labels, "
+          f"{len(trace['tasks'])} named tasks")
+
+    kind_counts = defaultdict(int)
+    for index, core in enumerate(trace['cores']):
+        records = core['records']
+        if not records:
+            print(f'\nCPU {index}: no records')
+            continue
+
+        span = records[-1]['ts'] - records[0]['ts']
+        busy = defaultdict(float)
+        running = None
+        for record in records:
+            kind_counts[record['kind']] += 1
+            if record['kind'] == KIND_TASK_SWITCH:
+                if running:
+                    busy[running[0]] += record['ts'] - running[1]
+                running = (record['task'], record['ts'])
+        if running:
+            busy[running[0]] += records[-1]['ts'] - running[1]
+
+        print(f"\nCPU {index}: {len(records)} records over {span / 1000:.1f} ms, {core['lost']} lost")
+        print(f"  {'Task':<20} {'Time ms':>10} {'Share':>7}")
+        for handle, us in sorted(busy.items(), key=lambda item: -item[1])[:args.top]:
+            share = 100.0 * us / span if span > 0 else 0.0
+            print(f'  {task_name(trace, handle):<20} {us / 1000:>10.2f} {share:>6.1f}%')
+
+    print('\nRecords by kind:')
+    for kind, count in sorted(kind_counts.items()):
+        name = KIND_NAMES[kind] if kind < len(KIND_NAMES) else f'kind {kind}'
+        print(f'  {name:<16} {count:>8}')
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert and summarize uFlake kernel traces')
+    sub = parser.add_subparsers(dest='command', required=True)
+
+    to_json = sub.add_parser('json', help='Convert to Chrome trace JSON (chrome://tracing, Perfetto)')
+    to_json.add_argument('trace', help='UFKT file (SD export or raw UART capture)')
+    to_json.add_argument('-o', '--output', help='Output file (default: <trace>.json)')
+    to_json.set_defaults(func=cmd_json)
+
+    summary = sub.add_parser('summary', help='CPU time per task and record counts')
+    summary.add_argument('trace', help='UFKT file (SD export or raw UART capture)')
+    summary.add_argument('--top', type=int, default=15, help='Task rows to show per core')
+    summary.set_defaults(func=cmd_summary)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
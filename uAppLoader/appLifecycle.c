@@ -1,6 +1,8 @@
 #include "appLifecycle.h"
 #include "appLoader.h"
+#include "uNVS.h"
 #include "esp_timer.h"
+#include <stdio.h>
 
 static const char *TAG = "APP_LIFECYCLE";
 
@@ -18,6 +20,76 @@ uflake_result_t app_lifecycle_init(void)
     return UFLAKE_OK;
 }
 
+// ============================================================================
+// STACK AUTO-SIZING
+// ============================================================================
+
+// NVS keys are limited to 15 characters and app names are not - key by hash
+static void app_stack_nvs_key(const char *name, char *key, size_t key_len)
+{
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (const char *p = name; *p; p++)
+    {
+        hash ^= (uint8_t)*p;
+        hash *= 16777619u;
+    }
+    snprintf(key, key_len, "s%08lx", (unsigned long)hash);
+}
+
+static uint32_t app_stack_size_for_launch(const app_descriptor_t *app)
+{
+    if (app->manifest.stack_size > 0)
+        return app->manifest.stack_size;
+
+    char key[UNVS_KEY_MAX_LEN + 1];
+    uint32_t learned = 0;
+    app_stack_nvs_key(app->manifest.name, key, sizeof(key));
+
+    if (unvs_read_u32(APP_STACK_NVS_NAMESPACE, key, &learned) == ESP_OK && learned >= APP_STACK_MIN_SIZE)
+    {
+        UFLAKE_LOGI(TAG, "Using learned stack size %lu for %s", learned, app->manifest.name);
+        return learned;
+    }
+
+    return APP_STACK_DEFAULT_SIZE;
+}
+
+// Persist a recommended stack size from the peak use of the run that is
+// ending. It only ever grows - a light run must not shrink the stack below
+// what an earlier, heavier run needed - and NVS is written only on change.
+// Apps with an explicit manifest stack_size never use it, so are skipped.
+static void app_stack_learn(const app_descriptor_t *app)
+{
+    uint32_t peak;
+    if (app->manifest.stack_size > 0 || !app->pid || uflake_process_get_stack_peak(app->pid, &peak) != UFLAKE_OK)
+        return;
+
+    uint32_t recommended = peak + peak * APP_STACK_MARGIN_PERCENT / 100;
+    recommended = (recommended + 255) & ~255u;
+    if (recommended < APP_STACK_MIN_SIZE)
+        recommended = APP_STACK_MIN_SIZE;
+
+    // A pooled launch gets a whole class anyway - anything smaller saves nothing
+    recommended = (uint32_t)uflake_process_pool_fit(recommended);
+
+    char key[UNVS_KEY_MAX_LEN + 1];
+    uint32_t stored = 0;
+    app_stack_nvs_key(app->manifest.name, key, sizeof(key));
+
+    if (unvs_read_u32(APP_STACK_NVS_NAMESPACE, key, &stored) == ESP_OK && stored >= recommended)
+    {
+        UFLAKE_LOGD(TAG, "App %s peak stack %lu bytes, learned size %lu unchanged",
+                    app->manifest.name, peak, stored);
+        return;
+    }
+
+    if (unvs_write_u32(APP_STACK_NVS_NAMESPACE, key, recommended) == ESP_OK)
+    {
+        UFLAKE_LOGI(TAG, "App %s peak stack %lu bytes, recommended stack size %lu",
+                    app->manifest.name, peak, recommended);
+    }
+}
+
 // ============================================================================
 // APP TASK WRAPPER
 // ============================================================================
@@ -30,8 +102,7 @@ void app_task_wrapper(void *arg)
     if (!app || !app->entry_point)
     {
         UFLAKE_LOGE(TAG, "Invalid app or entry point for ID %lu", app_id);
-        vTaskDelete(NULL);
-        return;
+        return; // process_wrapper deletes the task and recycles its slot
     }
 
     UFLAKE_LOGI(TAG, "Starting app: %s", app->manifest.name);
@@ -41,9 +112,12 @@ void app_task_wrapper(void *arg)
 
     UFLAKE_LOGI(TAG, "App %s exited", app->manifest.name);
 
+    app_stack_learn(app);
+
     // Clean up - mark as stopped
     app->state = APP_STATE_STOPPED;
     app->task_handle = NULL;
+    app->pid = 0;
 
     // If this was not the launcher, return to launcher
     if (!app->is_launcher)
@@ -56,7 +130,7 @@ void app_task_wrapper(void *arg)
         }
     }
 
-    vTaskDelete(NULL);
+    // Returning lets process_wrapper delete the task and recycle its slot
 }
 
 // ============================================================================
@@ -95,7 +169,7 @@ uflake_result_t app_lifecycle_launch(app_descriptor_t *app,
     }
 
     // Create task for app using uFlake kernel
-    uint32_t stack_size = app->manifest.stack_size > 0 ? app->manifest.stack_size : 4096;
+    uint32_t stack_size = app_stack_size_for_launch(app);
 
     // Map app priority to kernel priority
     process_priority_t kernel_priority = PROCESS_PRIORITY_NORMAL;
@@ -107,12 +181,13 @@ uflake_result_t app_lifecycle_launch(app_descriptor_t *app,
         kernel_priority = PROCESS_PRIORITY_LOW;
 
     uint32_t pid;
-    uflake_result_t result = uflake_process_create(
+    uflake_result_t result = uflake_process_create_ex(
         app->manifest.name,
         app_task_wrapper,
         (void *)(uintptr_t)app->app_id,
         stack_size,
         kernel_priority,
+        app->manifest.affinity,
         &pid);
 
     if (result != UFLAKE_OK)
@@ -123,6 +198,7 @@ uflake_result_t app_lifecycle_launch(app_descriptor_t *app,
 
     // Get the task handle from FreeRTOS
     app->task_handle = xTaskGetHandle(app->manifest.name);
+    app->pid = pid;
 
     app->state = APP_STATE_RUNNING;
     app->launch_count++;
@@ -150,11 +226,14 @@ uflake_result_t app_lifecycle_terminate(app_descriptor_t *app,
 
     UFLAKE_LOGI(TAG, "Terminating app: %s", app->manifest.name);
 
-    if (app->task_handle)
+    if (app->pid)
     {
+        app_stack_learn(app);
+
         // Use uFlake kernel to terminate (it will clean up properly)
-        vTaskDelete(app->task_handle);
+        uflake_process_terminate(app->pid);
         app->task_handle = NULL;
+        app->pid = 0;
     }
 
     app->state = APP_STATE_STOPPED;
@@ -21,7 +21,7 @@ static const char *TAG = "APP_LOADER";
 static app_descriptor_t app_registry[MAX_APPS];
 static uint32_t app_count = 0;
 static uint32_t next_app_id = 1;
-static uflake_mutex_t *app_loader_mutex = NULL;
+static uflake_rwlock_t *app_registry_lock = NULL; // Queries read, registration and lifecycle write
 static bool initialized = false;
 
 // Current app tracking
@@ -58,10 +58,10 @@ uflake_result_t app_loader_init(void)
         return UFLAKE_OK;
     }
 
-    // Create mutex using uFlake API
-    if (uflake_mutex_create(&app_loader_mutex) != UFLAKE_OK)
+    // Registry is read far more often than it changes
+    if (uflake_rwlock_create_named(&app_registry_lock, "app_loader") != UFLAKE_OK)
     {
-        UFLAKE_LOGE(TAG, "Failed to create mutex");
+        UFLAKE_LOGE(TAG, "Failed to create registry lock");
         return UFLAKE_ERROR_MEMORY;
     }
 
@@ -136,7 +136,7 @@ uint32_t app_loader_register_internal(const app_manifest_t *manifest,
         return 0;
     }
 
-    uflake_mutex_lock(app_loader_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(app_registry_lock, UINT32_MAX);
 
     app_descriptor_t *app = &app_registry[app_count];
     memset(app, 0, sizeof(app_descriptor_t));
@@ -164,7 +164,7 @@ uint32_t app_loader_register_internal(const app_manifest_t *manifest,
     }
 
     app_count++;
-    uflake_mutex_unlock(app_loader_mutex);
+    uflake_rwlock_write_unlock(app_registry_lock);
 
     return app->app_id;
 }
@@ -185,18 +185,18 @@ uflake_result_t app_loader_launch(uint32_t app_id)
     if (!initialized)
         return UFLAKE_ERROR;
 
-    uflake_mutex_lock(app_loader_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(app_registry_lock, UINT32_MAX);
 
     app_descriptor_t *app = app_loader_find_app_by_id(app_id);
     if (!app)
     {
-        uflake_mutex_unlock(app_loader_mutex);
+        uflake_rwlock_write_unlock(app_registry_lock);
         UFLAKE_LOGE(TAG, "App ID %lu not found", app_id);
         return UFLAKE_ERROR_NOT_FOUND;
     }
 
     uflake_result_t result = app_lifecycle_launch(app, launcher_app_id, &current_app_id);
-    uflake_mutex_unlock(app_loader_mutex);
+    uflake_rwlock_write_unlock(app_registry_lock);
 
     return result;
 }
@@ -206,17 +206,17 @@ uflake_result_t app_loader_terminate(uint32_t app_id)
     if (!initialized)
         return UFLAKE_ERROR;
 
-    uflake_mutex_lock(app_loader_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(app_registry_lock, UINT32_MAX);
 
     app_descriptor_t *app = app_loader_find_app_by_id(app_id);
     if (!app)
     {
-        uflake_mutex_unlock(app_loader_mutex);
+        uflake_rwlock_write_unlock(app_registry_lock);
         return UFLAKE_ERROR_NOT_FOUND;
     }
 
     uflake_result_t result = app_lifecycle_terminate(app, launcher_app_id, &current_app_id);
-    uflake_mutex_unlock(app_loader_mutex);
+    uflake_rwlock_write_unlock(app_registry_lock);
 
     return result;
 }
@@ -226,17 +226,17 @@ uflake_result_t app_loader_pause(uint32_t app_id)
     if (!initialized)
         return UFLAKE_ERROR;
 
-    uflake_mutex_lock(app_loader_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(app_registry_lock, UINT32_MAX);
 
     app_descriptor_t *app = app_loader_find_app_by_id(app_id);
     if (!app)
     {
-        uflake_mutex_unlock(app_loader_mutex);
+        uflake_rwlock_write_unlock(app_registry_lock);
         return UFLAKE_ERROR_NOT_FOUND;
     }
 
     uflake_result_t result = app_lifecycle_pause(app);
-    uflake_mutex_unlock(app_loader_mutex);
+    uflake_rwlock_write_unlock(app_registry_lock);
 
     return result;
 }
@@ -246,17 +246,17 @@ uflake_result_t app_loader_resume(uint32_t app_id)
     if (!initialized)
         return UFLAKE_ERROR;
 
-    uflake_mutex_lock(app_loader_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(app_registry_lock, UINT32_MAX);
 
     app_descriptor_t *app = app_loader_find_app_by_id(app_id);
     if (!app)
     {
-        uflake_mutex_unlock(app_loader_mutex);
+        uflake_rwlock_write_unlock(app_registry_lock);
         return UFLAKE_ERROR_NOT_FOUND;
     }
 
     uflake_result_t result = app_lifecycle_resume(app, &current_app_id);
-    uflake_mutex_unlock(app_loader_mutex);
+    uflake_rwlock_write_unlock(app_registry_lock);
 
     return result;
 }
@@ -270,12 +270,12 @@ uflake_result_t app_loader_get_apps(app_descriptor_t **apps, uint32_t *count)
     if (!initialized || !apps || !count)
         return UFLAKE_ERROR_INVALID_PARAM;
 
-    uflake_mutex_lock(app_loader_mutex, UINT32_MAX);
+    uflake_rwlock_read_lock(app_registry_lock, UINT32_MAX);
 
     *apps = app_registry;
     *count = app_count;
 
-    uflake_mutex_unlock(app_loader_mutex);
+    uflake_rwlock_read_unlock(app_registry_lock);
     return UFLAKE_OK;
 }
 
@@ -284,9 +284,9 @@ app_descriptor_t *app_loader_get_app(uint32_t app_id)
     if (!initialized)
         return NULL;
 
-    uflake_mutex_lock(app_loader_mutex, UINT32_MAX);
+    uflake_rwlock_read_lock(app_registry_lock, UINT32_MAX);
     app_descriptor_t *app = app_loader_find_app_by_id(app_id);
-    uflake_mutex_unlock(app_loader_mutex);
+    uflake_rwlock_read_unlock(app_registry_lock);
 
     return app;
 }
@@ -296,19 +296,19 @@ uint32_t app_loader_find_by_name(const char *name)
     if (!initialized || !name)
         return 0;
 
-    uflake_mutex_lock(app_loader_mutex, UINT32_MAX);
+    uflake_rwlock_read_lock(app_registry_lock, UINT32_MAX);
 
     for (uint32_t i = 0; i < app_count; i++)
     {
         if (strcmp(app_registry[i].manifest.name, name) == 0)
         {
             uint32_t app_id = app_registry[i].app_id;
-            uflake_mutex_unlock(app_loader_mutex);
+            uflake_rwlock_read_unlock(app_registry_lock);
             return app_id;
         }
     }
 
-    uflake_mutex_unlock(app_loader_mutex);
+    uflake_rwlock_read_unlock(app_registry_lock);
     return 0;
 }
 
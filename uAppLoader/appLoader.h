@@ -39,6 +39,13 @@ extern "C"
 
 #define FORCE_EXIT_HOLD_TIME_MS 2000 // Hold Right+Back for 2 seconds to force exit
 
+// Stack auto-sizing for apps whose manifest says stack_size=0: the peak stack
+// use of each run is persisted to NVS and sizes the next launch
+#define APP_STACK_DEFAULT_SIZE 4096      // Until a run has been measured
+#define APP_STACK_MIN_SIZE 3072          // Floor - the NVS write on exit runs on the app's stack
+#define APP_STACK_MARGIN_PERCENT 25      // Headroom on top of the deepest use seen
+#define APP_STACK_NVS_NAMESPACE "app_stack"
+
     // App types
     typedef enum
     {
@@ -73,8 +80,9 @@ extern "C"
         char description[APP_DESC_MAX_LEN]; // Short description
         char icon[APP_ICON_MAX_LEN];        // Icon filename
         app_type_t type;                    // App type
-        uint32_t stack_size;                // Task stack size (0 = default)
+        uint32_t stack_size;                // Task stack size (0 = auto-size from previous runs)
         uint32_t priority;                  // Task priority (0 = default)
+        process_affinity_t affinity;        // Core placement (0 = any core)
         bool requires_gui;                  // True if needs display
         bool requires_sdcard;               // True if needs SD card
         bool requires_network;              // True if needs WiFi/BT
@@ -91,6 +99,7 @@ extern "C"
         void *elf_handle;            // Handle for external apps
         app_state_t state;           // Current state
         TaskHandle_t task_handle;    // FreeRTOS task handle
+        uint32_t pid;                // uFlake process ID (0 = not running)
         bool is_launcher;            // True if this is launcher
         uint32_t launch_count;       // Times launched
         uint32_t last_run_time;      // Last launch timestamp
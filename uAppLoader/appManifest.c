@@ -91,8 +91,9 @@ uflake_result_t app_manifest_parse(const char *path, app_manifest_t *manifest)
     // description=Simple counter application
     // icon=counter.bmp
     // type=internal
-    // stack_size=4096
+    // stack_size=4096          (0 = auto-size from previous runs)
     // priority=5
+    // core=auto                (any | 0 | 1 | auto)
     // requires_gui=true
     // requires_sdcard=false
     // requires_network=false
@@ -166,6 +167,17 @@ uflake_result_t app_manifest_parse(const char *path, app_manifest_t *manifest)
         {
             manifest->priority = (uint32_t)atoi(value);
         }
+        else if (strcmp(key, "core") == 0)
+        {
+            if (strcmp(value, "0") == 0)
+                manifest->affinity = PROCESS_AFFINITY_CORE0;
+            else if (strcmp(value, "1") == 0)
+                manifest->affinity = PROCESS_AFFINITY_CORE1;
+            else if (strcmp(value, "auto") == 0)
+                manifest->affinity = PROCESS_AFFINITY_AUTO;
+            else
+                manifest->affinity = PROCESS_AFFINITY_ANY;
+        }
         else if (strcmp(key, "requires_gui") == 0)
         {
             manifest->requires_gui = (strcmp(value, "true") == 0);
@@ -212,6 +224,12 @@ uflake_result_t app_manifest_validate(const app_manifest_t *manifest)
         return UFLAKE_ERROR_INVALID_PARAM;
     }
 
+    if (manifest->affinity > PROCESS_AFFINITY_AUTO)
+    {
+        UFLAKE_LOGE(TAG, "Manifest validation failed: invalid core affinity %d", manifest->affinity);
+        return UFLAKE_ERROR_INVALID_PARAM;
+    }
+
     // Validate stack size
     if (manifest->stack_size > 0 && manifest->stack_size < 1024)
     {
@@ -242,8 +260,9 @@ void app_manifest_create_default(app_manifest_t *manifest,
     strcpy(manifest->icon, "default.bmp");
 
     manifest->type = APP_TYPE_INTERNAL;
-    manifest->stack_size = 4096;
+    manifest->stack_size = 0; // Auto-size from previous runs
     manifest->priority = 5;
+    manifest->affinity = PROCESS_AFFINITY_ANY;
     manifest->requires_gui = true;
     manifest->requires_sdcard = false;
     manifest->requires_network = false;
@@ -261,8 +280,15 @@ void app_manifest_print(const app_manifest_t *manifest)
     UFLAKE_LOGI(TAG, "Description: %s", manifest->description);
     UFLAKE_LOGI(TAG, "Icon:        %s", manifest->icon);
     UFLAKE_LOGI(TAG, "Type:        %s", app_type_to_string(manifest->type));
-    UFLAKE_LOGI(TAG, "Stack Size:  %lu bytes", manifest->stack_size);
+    if (manifest->stack_size > 0)
+        UFLAKE_LOGI(TAG, "Stack Size:  %lu bytes", manifest->stack_size);
+    else
+        UFLAKE_LOGI(TAG, "Stack Size:  auto");
     UFLAKE_LOGI(TAG, "Priority:    %lu", manifest->priority);
+    UFLAKE_LOGI(TAG, "Core:        %s", manifest->affinity == PROCESS_AFFINITY_CORE0   ? "0"
+                                        : manifest->affinity == PROCESS_AFFINITY_CORE1 ? "1"
+                                        : manifest->affinity == PROCESS_AFFINITY_AUTO  ? "auto"
+                                                                                       : "any");
     UFLAKE_LOGI(TAG, "Requires GUI:     %s", manifest->requires_gui ? "Yes" : "No");
     UFLAKE_LOGI(TAG, "Requires SD Card: %s", manifest->requires_sdcard ? "Yes" : "No");
     UFLAKE_LOGI(TAG, "Requires Network: %s", manifest->requires_network ? "Yes" : "No");
@@ -8,7 +8,7 @@ static const char *TAG = "SERVICE_MGR";
 static service_descriptor_t service_registry[MAX_SERVICES];
 static uint32_t service_count = 0;
 static uint32_t next_service_id = 1;
-static uflake_mutex_t *service_mutex = NULL;
+static uflake_rwlock_t *service_lock = NULL; // queries share it, lifecycle changes own it
 static bool initialized = false;
 
 // ============================================================================
@@ -53,8 +53,7 @@ static void service_task_wrapper(void *arg)
     if (!service)
     {
         UFLAKE_LOGE(TAG, "Invalid service ID %lu", service_id);
-        vTaskDelete(NULL);
-        return;
+        return; // process_wrapper deletes the task
     }
 
     UFLAKE_LOGI(TAG, "Service task started: %s", service->manifest.name);
@@ -68,7 +67,6 @@ static void service_task_wrapper(void *arg)
     }
 
     UFLAKE_LOGI(TAG, "Service task exiting: %s", service->manifest.name);
-    vTaskDelete(NULL);
 }
 
 // Check if service dependencies are met
@@ -100,10 +98,10 @@ uflake_result_t service_manager_init(void)
         return UFLAKE_OK;
     }
 
-    // Create mutex using uFlake API
-    if (uflake_mutex_create(&service_mutex) != UFLAKE_OK)
+    // Registry is looked up far more often than services start or stop
+    if (uflake_rwlock_create_named(&service_lock, "app_service") != UFLAKE_OK)
     {
-        UFLAKE_LOGE(TAG, "Failed to create mutex");
+        UFLAKE_LOGE(TAG, "Failed to create registry lock");
         return UFLAKE_ERROR_MEMORY;
     }
 
@@ -126,7 +124,7 @@ uflake_result_t service_manager_start_all(void)
 
     UFLAKE_LOGI(TAG, "Starting all auto-start services");
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(service_lock, UINT32_MAX);
 
     // Start services in dependency order (simple approach: multiple passes)
     bool started_any;
@@ -141,9 +139,9 @@ uflake_result_t service_manager_start_all(void)
                 service->state == SERVICE_STATE_STOPPED &&
                 check_dependencies(service))
             {
-                uflake_mutex_unlock(service_mutex);
+                uflake_rwlock_write_unlock(service_lock);
                 uflake_result_t result = service_start(service->service_id);
-                uflake_mutex_lock(service_mutex, UINT32_MAX);
+                uflake_rwlock_write_lock(service_lock, UINT32_MAX);
 
                 if (result == UFLAKE_OK)
                 {
@@ -152,7 +150,7 @@ uflake_result_t service_manager_start_all(void)
                 }
                 else if (service->manifest.critical)
                 {
-                    uflake_mutex_unlock(service_mutex);
+                    uflake_rwlock_write_unlock(service_lock);
                     UFLAKE_LOGE(TAG, "Critical service %s failed to start", service->manifest.name);
                     return UFLAKE_ERROR;
                 }
@@ -160,7 +158,7 @@ uflake_result_t service_manager_start_all(void)
         }
     } while (started_any);
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_write_unlock(service_lock);
 
     UFLAKE_LOGI(TAG, "Auto-start complete");
     return UFLAKE_OK;
@@ -173,20 +171,20 @@ uflake_result_t service_manager_stop_all(void)
 
     UFLAKE_LOGI(TAG, "Stopping all services");
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(service_lock, UINT32_MAX);
 
     // Stop in reverse order
     for (int i = service_count - 1; i >= 0; i--)
     {
         if (service_registry[i].state == SERVICE_STATE_RUNNING)
         {
-            uflake_mutex_unlock(service_mutex);
+            uflake_rwlock_write_unlock(service_lock);
             service_stop(service_registry[i].service_id);
-            uflake_mutex_lock(service_mutex, UINT32_MAX);
+            uflake_rwlock_write_lock(service_lock, UINT32_MAX);
         }
     }
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_write_unlock(service_lock);
 
     UFLAKE_LOGI(TAG, "All services stopped");
     return UFLAKE_OK;
@@ -210,7 +208,7 @@ uint32_t service_register(const service_bundle_t *service_bundle)
         return 0;
     }
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(service_lock, UINT32_MAX);
 
     service_descriptor_t *service = &service_registry[service_count];
     memset(service, 0, sizeof(service_descriptor_t));
@@ -236,7 +234,7 @@ uint32_t service_register(const service_bundle_t *service_bundle)
                 service->service_id,
                 service->manifest.type);
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_write_unlock(service_lock);
     return service->service_id;
 }
 
@@ -245,21 +243,21 @@ uflake_result_t service_unregister(uint32_t service_id)
     if (!initialized)
         return UFLAKE_ERROR;
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(service_lock, UINT32_MAX);
 
     service_descriptor_t *service = find_service_by_id(service_id);
     if (!service)
     {
-        uflake_mutex_unlock(service_mutex);
+        uflake_rwlock_write_unlock(service_lock);
         return UFLAKE_ERROR_NOT_FOUND;
     }
 
     // Stop service if running
     if (service->state == SERVICE_STATE_RUNNING)
     {
-        uflake_mutex_unlock(service_mutex);
+        uflake_rwlock_write_unlock(service_lock);
         service_stop(service_id);
-        uflake_mutex_lock(service_mutex, UINT32_MAX);
+        uflake_rwlock_write_lock(service_lock, UINT32_MAX);
     }
 
     // Remove from registry (shift array)
@@ -270,7 +268,7 @@ uflake_result_t service_unregister(uint32_t service_id)
     }
     service_count--;
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_write_unlock(service_lock);
 
     UFLAKE_LOGI(TAG, "Unregistered service ID %lu", service_id);
     return UFLAKE_OK;
@@ -285,19 +283,19 @@ uflake_result_t service_start(uint32_t service_id)
     if (!initialized)
         return UFLAKE_ERROR;
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(service_lock, UINT32_MAX);
 
     service_descriptor_t *service = find_service_by_id(service_id);
     if (!service)
     {
-        uflake_mutex_unlock(service_mutex);
+        uflake_rwlock_write_unlock(service_lock);
         UFLAKE_LOGE(TAG, "Service ID %lu not found", service_id);
         return UFLAKE_ERROR_NOT_FOUND;
     }
 
     if (service->state == SERVICE_STATE_RUNNING)
     {
-        uflake_mutex_unlock(service_mutex);
+        uflake_rwlock_write_unlock(service_lock);
         UFLAKE_LOGW(TAG, "Service %s already running", service->manifest.name);
         return UFLAKE_OK;
     }
@@ -305,7 +303,7 @@ uflake_result_t service_start(uint32_t service_id)
     // Check dependencies
     if (!check_dependencies(service))
     {
-        uflake_mutex_unlock(service_mutex);
+        uflake_rwlock_write_unlock(service_lock);
         UFLAKE_LOGE(TAG, "Service %s dependencies not met", service->manifest.name);
         return UFLAKE_ERROR;
     }
@@ -313,7 +311,7 @@ uflake_result_t service_start(uint32_t service_id)
     service->state = SERVICE_STATE_STARTING;
     UFLAKE_LOGI(TAG, "Starting service: %s", service->manifest.name);
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_write_unlock(service_lock);
 
     // Call init callback
     if (service->init)
@@ -322,10 +320,10 @@ uflake_result_t service_start(uint32_t service_id)
         if (result != UFLAKE_OK)
         {
             UFLAKE_LOGE(TAG, "Service %s init failed", service->manifest.name);
-            uflake_mutex_lock(service_mutex, UINT32_MAX);
+            uflake_rwlock_write_lock(service_lock, UINT32_MAX);
             service->state = SERVICE_STATE_ERROR;
             service->crash_count++;
-            uflake_mutex_unlock(service_mutex);
+            uflake_rwlock_write_unlock(service_lock);
             return result;
         }
     }
@@ -337,10 +335,10 @@ uflake_result_t service_start(uint32_t service_id)
         if (result != UFLAKE_OK)
         {
             UFLAKE_LOGE(TAG, "Service %s start failed", service->manifest.name);
-            uflake_mutex_lock(service_mutex, UINT32_MAX);
+            uflake_rwlock_write_lock(service_lock, UINT32_MAX);
             service->state = SERVICE_STATE_ERROR;
             service->crash_count++;
-            uflake_mutex_unlock(service_mutex);
+            uflake_rwlock_write_unlock(service_lock);
             return result;
         }
     }
@@ -361,40 +359,43 @@ uflake_result_t service_start(uint32_t service_id)
         snprintf(task_name, sizeof(task_name), "srv_%.27s", service->manifest.name);
 
         uint32_t pid;
-        uflake_result_t result = uflake_process_create(
+        uflake_result_t result = uflake_process_create_ex(
             task_name,
             service_task_wrapper,
             (void *)(uintptr_t)service_id,
             stack_size,
             kernel_priority,
+            service->manifest.affinity,
             &pid);
 
         if (result != UFLAKE_OK)
         {
             UFLAKE_LOGE(TAG, "Failed to create task for service %s", service->manifest.name);
-            uflake_mutex_lock(service_mutex, UINT32_MAX);
+            uflake_rwlock_write_lock(service_lock, UINT32_MAX);
             service->state = SERVICE_STATE_ERROR;
             service->crash_count++;
-            uflake_mutex_unlock(service_mutex);
+            uflake_rwlock_write_unlock(service_lock);
             return result;
         }
 
-        uflake_mutex_lock(service_mutex, UINT32_MAX);
+        uflake_rwlock_write_lock(service_lock, UINT32_MAX);
         service->task_handle = xTaskGetHandle(task_name);
+        service->pid = pid;
         service->state = SERVICE_STATE_RUNNING;
         service->start_count++;
         service->last_start_time = (uint32_t)(esp_timer_get_time() / 1000000);
-        uflake_mutex_unlock(service_mutex);
+        uflake_rwlock_write_unlock(service_lock);
         UFLAKE_LOGI(TAG, "Service %s started successfully", service->manifest.name);
         return UFLAKE_OK;
     } else {
         // No task needed, just mark as running
-        uflake_mutex_lock(service_mutex, UINT32_MAX);
+        uflake_rwlock_write_lock(service_lock, UINT32_MAX);
         service->task_handle = NULL;
+        service->pid = 0;
         service->state = SERVICE_STATE_RUNNING;
         service->start_count++;
         service->last_start_time = (uint32_t)(esp_timer_get_time() / 1000000);
-        uflake_mutex_unlock(service_mutex);
+        uflake_rwlock_write_unlock(service_lock);
         UFLAKE_LOGI(TAG, "Service %s started (no task)", service->manifest.name);
         return UFLAKE_OK;
     }
@@ -405,25 +406,25 @@ uflake_result_t service_stop(uint32_t service_id)
     if (!initialized)
         return UFLAKE_ERROR;
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(service_lock, UINT32_MAX);
 
     service_descriptor_t *service = find_service_by_id(service_id);
     if (!service)
     {
-        uflake_mutex_unlock(service_mutex);
+        uflake_rwlock_write_unlock(service_lock);
         return UFLAKE_ERROR_NOT_FOUND;
     }
 
     if (service->state != SERVICE_STATE_RUNNING)
     {
-        uflake_mutex_unlock(service_mutex);
+        uflake_rwlock_write_unlock(service_lock);
         return UFLAKE_OK; // Already stopped
     }
 
     service->state = SERVICE_STATE_STOPPING;
     UFLAKE_LOGI(TAG, "Stopping service: %s", service->manifest.name);
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_write_unlock(service_lock);
 
     // Call stop callback
     if (service->stop)
@@ -438,17 +439,18 @@ uflake_result_t service_stop(uint32_t service_id)
     }
 
     // Delete task
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(service_lock, UINT32_MAX);
 
-    if (service->task_handle)
+    if (service->pid)
     {
-        vTaskDelete(service->task_handle);
+        uflake_process_terminate(service->pid);
         service->task_handle = NULL;
+        service->pid = 0;
     }
 
     service->state = SERVICE_STATE_STOPPED;
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_write_unlock(service_lock);
 
     UFLAKE_LOGI(TAG, "Service %s stopped", service->manifest.name);
     return UFLAKE_OK;
@@ -489,12 +491,12 @@ uflake_result_t service_get_all(service_descriptor_t **services, uint32_t *count
     if (!initialized || !services || !count)
         return UFLAKE_ERROR_INVALID_PARAM;
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_read_lock(service_lock, UINT32_MAX);
 
     *services = service_registry;
     *count = service_count;
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_read_unlock(service_lock);
     return UFLAKE_OK;
 }
 
@@ -503,9 +505,9 @@ service_descriptor_t *service_get(uint32_t service_id)
     if (!initialized)
         return NULL;
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_read_lock(service_lock, UINT32_MAX);
     service_descriptor_t *service = find_service_by_id(service_id);
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_read_unlock(service_lock);
 
     return service;
 }
@@ -515,19 +517,19 @@ uint32_t service_find_by_name(const char *name)
     if (!initialized || !name)
         return 0;
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_read_lock(service_lock, UINT32_MAX);
 
     for (uint32_t i = 0; i < service_count; i++)
     {
         if (strcmp(service_registry[i].manifest.name, name) == 0)
         {
             uint32_t service_id = service_registry[i].service_id;
-            uflake_mutex_unlock(service_mutex);
+            uflake_rwlock_read_unlock(service_lock);
             return service_id;
         }
     }
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_read_unlock(service_lock);
     return 0;
 }
 
@@ -536,12 +538,12 @@ bool service_is_running(uint32_t service_id)
     if (!initialized)
         return false;
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_read_lock(service_lock, UINT32_MAX);
 
     service_descriptor_t *service = find_service_by_id(service_id);
     bool running = (service && service->state == SERVICE_STATE_RUNNING);
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_read_unlock(service_lock);
     return running;
 }
 
@@ -550,11 +552,11 @@ void *service_get_context(uint32_t service_id)
     if (!initialized)
         return NULL;
 
-    uflake_mutex_lock(service_mutex, UINT32_MAX);
+    uflake_rwlock_read_lock(service_lock, UINT32_MAX);
 
     service_descriptor_t *service = find_service_by_id(service_id);
     void *context = service ? service->context : NULL;
 
-    uflake_mutex_unlock(service_mutex);
+    uflake_rwlock_read_unlock(service_lock);
     return context;
 }
@@ -49,6 +49,7 @@ extern "C"
         service_type_t type;                   // Service category
         uint32_t stack_size;                   // Task stack size (0 = default)
         uint32_t priority;                     // Task priority (0 = default)
+        process_affinity_t affinity;           // Core placement (0 = any core)
         bool auto_start;                       // Auto-start on boot
         bool critical;                         // System-critical service
         uint32_t dependencies[MAX_SERVICES];   // Array of service IDs this depends on (0-terminated)
@@ -61,6 +62,7 @@ extern "C"
         service_manifest_t manifest; // Service metadata
         service_state_t state;       // Current state
         TaskHandle_t task_handle;    // FreeRTOS task handle
+        uint32_t pid;                // uFlake process ID (0 = no task)
         void *context;               // Service-specific context data
 
         // Lifecycle callbacks
@@ -175,6 +175,24 @@ static void render_text_overlay(uint16_t *buffer, int buffer_y, int frame,
     (void)height;
 }
 
+typedef struct
+{
+    uint16_t *buffer;
+    int strip_y;
+    int frame;
+    int width;
+} plasma_strip_t;
+
+static void render_plasma_lines(uint32_t line_begin, uint32_t line_end, void *arg)
+{
+    const plasma_strip_t *strip = (const plasma_strip_t *)arg;
+
+    for (uint32_t y = line_begin; y < line_end; y++)
+    {
+        render_plasma_line(&strip->buffer[y * strip->width], strip->strip_y + y, strip->frame, strip->width);
+    }
+}
+
 // Render one strip of the boot screen
 static void render_boot_screen_strip(st7789_driver_t *driver, int strip_y, int strip_height)
 {
@@ -185,11 +203,9 @@ static void render_boot_screen_strip(st7789_driver_t *driver, int strip_y, int s
     int frame = boot_state.frame;
     const int width = driver->display_width;
 
-    // Render plasma for this strip
-    for (int y = 0; y < strip_height; y++)
-    {
-        render_plasma_line(&buffer[y * width], strip_y + y, frame, width);
-    }
+    // Render plasma for this strip, lines split across both cores
+    plasma_strip_t strip = {.buffer = buffer, .strip_y = strip_y, .frame = frame, .width = width};
+    uflake_job_parallel_for(0, strip_height, BOOT_SCREEN_LINES_PER_JOB, render_plasma_lines, &strip);
 
     // Add text overlay if in visible range (centered for landscape mode)
     if (frame < 100 && strip_y < 150 && (strip_y + strip_height) > 90)
@@ -293,12 +309,13 @@ esp_err_t uboot_screen_start(st7789_driver_t *driver)
     UFLAKE_LOGI(TAG, "Creating boot screen task");
 
     uint32_t gui_pid;
-    if (uflake_process_create("Boot_Screen_Task",
-                              boot_screen_task,
-                              driver,
-                              4096,
-                              BOOT_SCREEN_TASK_PRIORITY,
-                              &gui_pid) != UFLAKE_OK)
+    if (uflake_process_create_ex("Boot_Screen_Task",
+                                 boot_screen_task,
+                                 driver,
+                                 4096,
+                                 BOOT_SCREEN_TASK_PRIORITY,
+                                 BOOT_SCREEN_TASK_AFFINITY,
+                                 &gui_pid) != UFLAKE_OK)
     {
         UFLAKE_LOGE(TAG, "Failed to create GUI process");
         return ESP_FAIL;
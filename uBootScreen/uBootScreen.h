@@ -16,10 +16,11 @@ extern "C"
     // Boot screen configuration
 
 #define BOOT_SCREEN_STRIP_HEIGHT 20 // Render in strips for memory efficiency
+#define BOOT_SCREEN_LINES_PER_JOB 5  // Plasma lines per parallel job
 #define BOOT_SCREEN_FPS 30
 #define BOOT_SCREEN_DURATION_FRAMES 120 // Show for 2 seconds at 60 FPS
 #define BOOT_SCREEN_TASK_PRIORITY 5
-#define BOOT_SCREEN_TASK_CORE 1 // Run on core 1
+#define BOOT_SCREEN_TASK_AFFINITY PROCESS_AFFINITY_CORE1 // Run on core 1
 
     // Boot screen state structure
     typedef struct
@@ -1,5 +1,6 @@
 #include "uI2c.h"
 #include <string.h>
+#include <stdio.h>
 
 static const char *TAG = "UI2C";
 
@@ -150,7 +151,9 @@ uflake_result_t i2c_bus_manager_init(i2c_port_t port, gpio_num_t sda_pin, gpio_n
     }
 
     // Create mutex for this bus
-    if (uflake_mutex_create(&u_i2c_buses[port].mutex) != UFLAKE_OK)
+    char mutex_name[UFLAKE_MUTEX_NAME_LEN];
+    snprintf(mutex_name, sizeof(mutex_name), "i2c%d", port);
+    if (uflake_mutex_create_named(&u_i2c_buses[port].mutex, mutex_name) != UFLAKE_OK)
     {
         UFLAKE_LOGE(TAG, "Failed to create mutex for I2C port %d", port);
         return UFLAKE_ERROR_MEMORY;
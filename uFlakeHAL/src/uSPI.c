@@ -1,5 +1,6 @@
 #include "uSPI.h"
 #include <string.h>
+#include <stdio.h>
 
 static const char *TAG = "USPI";
 
@@ -8,7 +9,7 @@ typedef struct
 {
     spi_host_device_t host;
     bool is_initialized;
-    uflake_mutex_t *mutex;
+    uflake_rwlock_t *lock; // guards device_list - lookups share it, add/remove own it
     gpio_num_t mosi_pin;
     gpio_num_t miso_pin;
     gpio_num_t sclk_pin;
@@ -35,6 +36,20 @@ static uspi_bus_state_t uspi_buses[SOC_SPI_PERIPH_NUM] = {0};
 // PRIVATE HELPER FUNCTIONS
 // ============================================================================
 
+// Kernel trace hooks, run by the SPI driver from its ISR. The label lives in
+// DRAM since it may be interned while the flash cache is disabled.
+static DRAM_ATTR const char uspi_trace_label[] = "spi";
+
+static void IRAM_ATTR uspi_trace_pre_cb(spi_transaction_t *trans)
+{
+    uflake_kernel_trace_record(KERNEL_TRACE_SPI_BEGIN, uspi_trace_label, (uint32_t)(trans->length / 8));
+}
+
+static void IRAM_ATTR uspi_trace_post_cb(spi_transaction_t *trans)
+{
+    uflake_kernel_trace_record(KERNEL_TRACE_SPI_END, uspi_trace_label, (uint32_t)(trans->length / 8));
+}
+
 static spi_device_node_t *find_device_node(uspi_bus_state_t *bus, spi_device_handle_t handle)
 {
     spi_device_node_t *current = bus->device_list;
@@ -129,10 +144,12 @@ uflake_result_t uspi_bus_init(spi_host_device_t host, gpio_num_t mosi, gpio_num_
         return UFLAKE_OK;
     }
 
-    // Create mutex for this bus
-    if (uflake_mutex_create(&uspi_buses[host].mutex) != UFLAKE_OK)
+    // Create lock for this bus
+    char lock_name[UFLAKE_MUTEX_NAME_LEN];
+    snprintf(lock_name, sizeof(lock_name), "spi%d", host);
+    if (uflake_rwlock_create_named(&uspi_buses[host].lock, lock_name) != UFLAKE_OK)
     {
-        UFLAKE_LOGE(TAG, "Failed to create mutex for SPI host %d", host);
+        UFLAKE_LOGE(TAG, "Failed to create lock for SPI host %d", host);
         return UFLAKE_ERROR_MEMORY;
     }
 
@@ -151,7 +168,7 @@ uflake_result_t uspi_bus_init(spi_host_device_t host, gpio_num_t mosi, gpio_num_
     if (ret != ESP_OK)
     {
         UFLAKE_LOGE(TAG, "SPI bus init failed: %s", esp_err_to_name(ret));
-        uflake_mutex_destroy(uspi_buses[host].mutex);
+        uflake_rwlock_destroy(uspi_buses[host].lock);
         return UFLAKE_ERROR;
     }
 
@@ -178,7 +195,7 @@ esp_err_t uspi_bus_deinit(spi_host_device_t host)
         return ESP_ERR_INVALID_STATE;
     }
 
-    uflake_mutex_lock(uspi_buses[host].mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(uspi_buses[host].lock, UINT32_MAX);
 
     // Free all device nodes
     spi_device_node_t *current = uspi_buses[host].device_list;
@@ -193,8 +210,8 @@ esp_err_t uspi_bus_deinit(spi_host_device_t host)
     // Free SPI bus
     esp_err_t ret = spi_bus_free(host);
 
-    uflake_mutex_unlock(uspi_buses[host].mutex);
-    uflake_mutex_destroy(uspi_buses[host].mutex);
+    uflake_rwlock_write_unlock(uspi_buses[host].lock);
+    uflake_rwlock_destroy(uspi_buses[host].lock);
 
     uspi_buses[host].is_initialized = false;
     uspi_buses[host].device_list = NULL;
@@ -224,7 +241,7 @@ esp_err_t uspi_device_add(spi_host_device_t host, const uspi_device_config_t *de
         return ESP_ERR_NO_MEM;
     }
 
-    uflake_mutex_lock(uspi_buses[host].mutex, UINT32_MAX);
+    uflake_rwlock_write_lock(uspi_buses[host].lock, UINT32_MAX);
 
     // Configure SPI device
     spi_device_interface_config_t devcfg = {
@@ -236,8 +253,8 @@ esp_err_t uspi_device_add(spi_host_device_t host, const uspi_device_config_t *de
         .spics_io_num = dev_config->cs_pin,
         .queue_size = dev_config->queue_size > 0 ? dev_config->queue_size : 7,
         .flags = 0,
-        .pre_cb = NULL,
-        .post_cb = NULL};
+        .pre_cb = uspi_trace_pre_cb,
+        .post_cb = uspi_trace_post_cb};
 
     if (dev_config->cs_ena_pretrans)
     {
@@ -247,7 +264,7 @@ esp_err_t uspi_device_add(spi_host_device_t host, const uspi_device_config_t *de
     esp_err_t ret = spi_bus_add_device(host, &devcfg, out_handle);
     if (ret != ESP_OK)
     {
-        uflake_mutex_unlock(uspi_buses[host].mutex);
+        uflake_rwlock_write_unlock(uspi_buses[host].lock);
         UFLAKE_LOGE(TAG, "Failed to add SPI device: %s", esp_err_to_name(ret));
         return ret;
     }
@@ -255,7 +272,7 @@ esp_err_t uspi_device_add(spi_host_device_t host, const uspi_device_config_t *de
     // Add to device list
     ret = add_device_to_list(&uspi_buses[host], *out_handle, dev_config);
 
-    uflake_mutex_unlock(uspi_buses[host].mutex);
+    uflake_rwlock_write_unlock(uspi_buses[host].lock);
 
     return ret;
 }
@@ -273,7 +290,7 @@ esp_err_t uspi_device_remove(spi_device_handle_t handle)
         if (!uspi_buses[host].is_initialized)
             continue;
 
-        uflake_mutex_lock(uspi_buses[host].mutex, UINT32_MAX);
+        uflake_rwlock_write_lock(uspi_buses[host].lock, UINT32_MAX);
 
         if (find_device_node(&uspi_buses[host], handle))
         {
@@ -282,11 +299,11 @@ esp_err_t uspi_device_remove(spi_device_handle_t handle)
             {
                 remove_device_from_list(&uspi_buses[host], handle);
             }
-            uflake_mutex_unlock(uspi_buses[host].mutex);
+            uflake_rwlock_write_unlock(uspi_buses[host].lock);
             return ret;
         }
 
-        uflake_mutex_unlock(uspi_buses[host].mutex);
+        uflake_rwlock_write_unlock(uspi_buses[host].lock);
     }
 
     return ESP_ERR_NOT_FOUND;
@@ -529,17 +546,17 @@ esp_err_t uspi_get_device_info(spi_device_handle_t handle, uspi_device_config_t
         if (!uspi_buses[host].is_initialized)
             continue;
 
-        uflake_mutex_lock(uspi_buses[host].mutex, UINT32_MAX);
+        uflake_rwlock_read_lock(uspi_buses[host].lock, UINT32_MAX);
 
         spi_device_node_t *node = find_device_node(&uspi_buses[host], handle);
         if (node)
         {
             *info = node->config;
-            uflake_mutex_unlock(uspi_buses[host].mutex);
+            uflake_rwlock_read_unlock(uspi_buses[host].lock);
             return ESP_OK;
         }
 
-        uflake_mutex_unlock(uspi_buses[host].mutex);
+        uflake_rwlock_read_unlock(uspi_buses[host].lock);
     }
 
     return ESP_ERR_NOT_FOUND;
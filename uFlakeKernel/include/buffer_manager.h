@@ -8,21 +8,23 @@ extern "C"
 {
 #endif
 
-    typedef struct
+    struct uflake_buffer_t
     {
         void *data;
         size_t size;
         size_t capacity;
         uint32_t ref_count;
         bool is_allocated;
-    } uflake_buffer_t;
+    };
 
     uflake_result_t uflake_buffer_init(void);
     uflake_result_t uflake_buffer_create(uflake_buffer_t **buffer, size_t capacity);
+    uflake_result_t uflake_buffer_create_in(uflake_buffer_t **buffer, size_t capacity, uflake_mem_type_t mem_type);
+    uflake_result_t uflake_buffer_retain(uflake_buffer_t *buffer); // +1 reference, release with uflake_buffer_destroy
     uflake_result_t uflake_buffer_write(uflake_buffer_t *buffer, const void *data, size_t size);
     uflake_result_t uflake_buffer_read(uflake_buffer_t *buffer, void *data, size_t size);
     uflake_result_t uflake_buffer_resize(uflake_buffer_t *buffer, size_t new_capacity);
-    uflake_result_t uflake_buffer_destroy(uflake_buffer_t *buffer);
+    uflake_result_t uflake_buffer_destroy(uflake_buffer_t *buffer); // -1 reference, frees on last
 
 #ifdef __cplusplus
 }
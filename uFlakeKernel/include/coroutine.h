@@ -0,0 +1,163 @@
+#ifndef UFLAKE_COROUTINE_H
+#define UFLAKE_COROUTINE_H
+
+// Not part of the kernel.h umbrella: the control block embeds event and
+// message types, so include this header directly where coroutines are used.
+#include "../kernel.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// All coroutines run on one worker task and share its stack
+#define UFLAKE_CORO_WORKER_STACK_SIZE 4096
+#define UFLAKE_CORO_WORKER_PRIORITY (PROCESS_PRIORITY_NORMAL + 1) // Same FreeRTOS priority as normal processes
+#define UFLAKE_CORO_MAX_NAME 16
+#define UFLAKE_CORO_MAX_EVENTS 16 // Distinct event names coroutines can await
+#define UFLAKE_CORO_FOREVER UINT32_MAX
+
+    typedef enum
+    {
+        UFLAKE_CORO_WAITING = 0, // Suspended at an await or yield
+        UFLAKE_CORO_DONE         // Finished, the coroutine is freed
+    } uflake_coro_status_t;
+
+    typedef enum
+    {
+        CORO_WAIT_READY = 0, // Runnable
+        CORO_WAIT_TIMER,
+        CORO_WAIT_QUEUE,
+        CORO_WAIT_EVENT
+    } uflake_coro_wait_t;
+
+    typedef struct uflake_coro_t uflake_coro_t;
+
+    /**
+     * @brief Coroutine body, called again from the top on every resume
+     *
+     * Locals do not survive an await - keep state in ctx. The body is
+     * wrapped in UFLAKE_CORO_BEGIN / UFLAKE_CORO_END and must not contain
+     * a switch statement that spans an await.
+     */
+    typedef uflake_coro_status_t (*uflake_coro_fn_t)(uflake_coro_t *coro, void *ctx);
+
+    // Coroutine control block (~200 bytes). Fields are managed by the worker and the macros.
+    struct uflake_coro_t
+    {
+        uint32_t id;
+        char name[UFLAKE_CORO_MAX_NAME];
+        uflake_coro_fn_t fn;
+        void *ctx;
+        uint32_t resume_line; // Resume point, 0 = start
+        uflake_coro_wait_t wait;
+        uflake_result_t wait_result; // Result of the last await
+        int64_t deadline_us;         // Timer wake-up or await timeout, 0 = none
+        uflake_msgqueue_t *queue;    // CORO_WAIT_QUEUE
+        uflake_message_t *message;   // Receives the message, owned by the caller
+        char event_name[UFLAKE_MAX_EVENT_NAME];
+        uflake_event_t event; // Copy of the awaited event, valid until the next await
+        bool has_event;
+        bool cancelled;
+        uint32_t resumes;
+        struct uflake_coro_t *next;
+    };
+
+    // Protothread-style control flow (switch on the resume line). Every await
+    // returns to the worker; at most one await per source line.
+#define UFLAKE_CORO_BEGIN(coro)  \
+    switch ((coro)->resume_line) \
+    {                            \
+    case 0:
+
+#define UFLAKE_CORO_END(coro) \
+    }                         \
+    return UFLAKE_CORO_DONE
+
+#define UFLAKE_CORO_SUSPEND_(coro)  \
+    (coro)->resume_line = __LINE__; \
+    return UFLAKE_CORO_WAITING;     \
+    case __LINE__:
+
+    // Let the other coroutines run, resume on the next pass
+#define UFLAKE_CORO_YIELD(coro)       \
+    do                                \
+    {                                 \
+        uflake_coro_wait_ready(coro); \
+        UFLAKE_CORO_SUSPEND_(coro);   \
+    } while (0)
+
+    // Resume after delay_ms
+#define UFLAKE_CORO_AWAIT_MS(coro, delay_ms)    \
+    do                                          \
+    {                                           \
+        uflake_coro_wait_timer(coro, delay_ms); \
+        UFLAKE_CORO_SUSPEND_(coro);             \
+    } while (0)
+
+    // Resume with a message in *msg (msg must outlive the await), on timeout, or with
+    // UFLAKE_ERROR_NOT_FOUND if mq is destroyed meanwhile
+#define UFLAKE_CORO_AWAIT_QUEUE(coro, mq, msg, timeout_ms) \
+    do                                                     \
+    {                                                      \
+        uflake_coro_wait_queue(coro, mq, msg, timeout_ms); \
+        UFLAKE_CORO_SUSPEND_(coro);                        \
+    } while (0)
+
+    // Resume when event_name is dispatched (see uflake_coro_event()), or on timeout
+#define UFLAKE_CORO_AWAIT_EVENT(coro, event_name, timeout_ms) \
+    do                                                        \
+    {                                                         \
+        uflake_coro_wait_event(coro, event_name, timeout_ms); \
+        UFLAKE_CORO_SUSPEND_(coro);                           \
+    } while (0)
+
+    uflake_result_t uflake_coro_init(void);
+
+    /**
+     * @brief Create a coroutine on the shared worker task
+     *
+     * Costs one control block instead of a task stack. The body runs on the
+     * worker, so it must never block - wait with the UFLAKE_CORO_AWAIT_*
+     * macros instead of vTaskDelay or blocking queue/mutex calls.
+     *
+     * @param coro_id Optional, for uflake_coro_cancel()
+     */
+    uflake_result_t uflake_coro_create(const char *name, uflake_coro_fn_t fn, void *ctx, uint32_t *coro_id);
+
+    // Stop a coroutine at its current await; it is freed without resuming
+    uflake_result_t uflake_coro_cancel(uint32_t coro_id);
+
+    // Result of the last await: UFLAKE_OK, UFLAKE_ERROR_TIMEOUT, or an error if it could not wait
+    static inline uflake_result_t uflake_coro_wait_result(const uflake_coro_t *coro)
+    {
+        return coro->wait_result;
+    }
+
+    // Event that completed the last UFLAKE_CORO_AWAIT_EVENT, NULL on timeout
+    static inline const uflake_event_t *uflake_coro_event(const uflake_coro_t *coro)
+    {
+        return coro->has_event ? &coro->event : NULL;
+    }
+
+    // Wake the worker after a message was sent to a queue coroutines wait on
+    void uflake_coro_notify(void);
+    void uflake_coro_notify_from_isr(BaseType_t *higher_priority_task_woken);
+
+    // Called by uflake_msgqueue_destroy() before the queue is freed - ends every wait on it
+    void uflake_coro_queue_destroyed(uflake_msgqueue_t *queue);
+
+    void uflake_coro_print_status(void);
+
+    // Used by the await macros
+    void uflake_coro_wait_ready(uflake_coro_t *coro);
+    void uflake_coro_wait_timer(uflake_coro_t *coro, uint32_t delay_ms);
+    void uflake_coro_wait_queue(uflake_coro_t *coro, uflake_msgqueue_t *queue, uflake_message_t *message,
+                                uint32_t timeout_ms);
+    void uflake_coro_wait_event(uflake_coro_t *coro, const char *event_name, uint32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UFLAKE_COROUTINE_H
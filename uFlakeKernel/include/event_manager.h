@@ -10,6 +10,7 @@ extern "C"
 
 #define UFLAKE_MAX_EVENT_NAME 32
 #define UFLAKE_MAX_EVENT_DATA 64
+#define UFLAKE_ISR_EVENT_SLOTS 16 // Must be a power of two
 
     typedef enum
     {
@@ -20,6 +21,15 @@ extern "C"
         EVENT_TYPE_ERROR
     } event_type_t;
 
+    // Per-event-name publish policies (for bursty publishers)
+    typedef enum
+    {
+        EVENT_POLICY_NONE = 0, // Queue every publish (default)
+        EVENT_POLICY_COALESCE, // Keep only the latest payload until next dispatch
+        EVENT_POLICY_DEBOUNCE, // Dispatch latest payload once publishes stop for param_ms
+        EVENT_POLICY_MAX_RATE  // Dispatch at most once every param_ms (latest payload wins)
+    } event_policy_t;
+
     typedef void (*event_callback_t)(const void *event_data);
 
     typedef struct
@@ -29,6 +39,7 @@ extern "C"
         uint32_t timestamp;
         size_t data_size;
         uint8_t data[UFLAKE_MAX_EVENT_DATA];
+        uflake_buffer_t *buffer; // Shared payload (publish_buffer), NULL otherwise
     } uflake_event_t;
 
     typedef struct
@@ -42,11 +53,52 @@ extern "C"
     uflake_result_t uflake_event_init(void);
     uflake_result_t uflake_event_publish(const char *event_name, event_type_t type,
                                          const void *data, size_t data_size);
+
+    /**
+     * @brief Publish an event from interrupt context
+     *
+     * Lock-free: claims a pre-sized slot in the ISR event ring and wakes the
+     * kernel task with vTaskNotifyGiveFromISR. Never blocks and never logs.
+     * uflake_event_publish() forwards here automatically when called from an ISR.
+     *
+     * @return UFLAKE_ERROR_MEMORY if the ring is full (event dropped)
+     */
+    uflake_result_t uflake_event_publish_from_isr(const char *event_name, event_type_t type,
+                                                  const void *data, size_t data_size);
+
+    /**
+     * @brief Publish an event whose payload is a refcounted shared buffer
+     *
+     * The event takes its own reference, so the caller may release its
+     * reference right after publishing. Every subscriber sees the same buffer
+     * via event->buffer (zero copy); the event's reference is dropped after the
+     * last callback returns. A subscriber that keeps the data past its callback
+     * must call uflake_buffer_retain() and later uflake_buffer_destroy().
+     * Not ISR-safe.
+     */
+    uflake_result_t uflake_event_publish_buffer(const char *event_name, event_type_t type,
+                                                uflake_buffer_t *buffer);
     uflake_result_t uflake_event_subscribe(const char *event_name, event_callback_t callback,
                                            uint32_t *subscription_id);
     uflake_result_t uflake_event_unsubscribe(uint32_t subscription_id);
     void uflake_event_process(void);
 
+    // Ticks until uflake_event_process() has work (0 = now, portMAX_DELAY = none)
+    TickType_t uflake_event_next_wakeup(void);
+
+    /**
+     * @brief Set the publish policy for an event name
+     *
+     * Events with a policy never touch the event queue: publish only overwrites
+     * a per-name slot and returns immediately, and uflake_event_process()
+     * dispatches the slot when the policy allows it.
+     *
+     * @param event_name Event name the policy applies to
+     * @param policy Policy (EVENT_POLICY_NONE removes it)
+     * @param param_ms Debounce quiet time / max-rate interval (ignored for COALESCE)
+     */
+    uflake_result_t uflake_event_set_policy(const char *event_name, event_policy_t policy, uint32_t param_ms);
+
 // Pre-defined system events
 #define UFLAKE_EVENT_PROCESS_CREATED "proc.created"
 #define UFLAKE_EVENT_PROCESS_TERMINATED "proc.terminated"
@@ -0,0 +1,74 @@
+#ifndef UFLAKE_EVENT_TRACE_H
+#define UFLAKE_EVENT_TRACE_H
+
+#include "../kernel.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define UFLAKE_EVENT_TRACE_MAGIC 0x54454655 // "UFET" little-endian
+#define UFLAKE_EVENT_TRACE_VERSION 1
+#define UFLAKE_EVENT_TRACE_MAX_NAMES 64
+#define UFLAKE_EVENT_TRACE_DEFAULT_RECORDS 8192 // 128 KB in PSRAM
+
+    // Trace record kinds
+    typedef enum
+    {
+        EVENT_TRACE_PUBLISH = 0,     // Event accepted by publish (task context)
+        EVENT_TRACE_PUBLISH_ISR = 1, // Event accepted by publish_from_isr
+        EVENT_TRACE_DISPATCH = 2,    // Dispatcher picked the event up
+        EVENT_TRACE_CB_START = 3,    // Subscriber callback entered
+        EVENT_TRACE_CB_END = 4,      // Subscriber callback returned
+        EVENT_TRACE_DROP = 5         // Event lost (queue/ring full)
+    } event_trace_kind_t;
+
+    // Record flags
+#define EVENT_TRACE_FLAG_POLICED 0x01 // Event name has a publish policy
+#define EVENT_TRACE_FLAG_BUFFER 0x02  // Payload is a shared buffer
+
+    // Binary record - 16 bytes, exported as-is (little-endian)
+    typedef struct __attribute__((packed))
+    {
+        uint32_t timestamp_us;    // Low 32 bits of esp_timer_get_time()
+        uint32_t subscription_id; // CB_START/CB_END only, 0 otherwise
+        uint16_t name_id;         // Index into the exported name table
+        uint8_t kind;             // event_trace_kind_t
+        uint8_t flags;            // EVENT_TRACE_FLAG_*
+        uint16_t data_size;       // Payload size (buffer size for shared buffers)
+        uint16_t subscriber_pid;  // CB_START/CB_END only, 0 otherwise
+    } uflake_event_trace_record_t;
+
+    // Writer used by uflake_event_trace_export() - return bytes written
+    typedef size_t (*event_trace_writer_t)(const void *data, size_t size, void *ctx);
+
+    /**
+     * @brief Start recording into a ring of max_records entries (PSRAM when available)
+     * @param max_records Ring capacity (0 = UFLAKE_EVENT_TRACE_DEFAULT_RECORDS); oldest records are overwritten
+     */
+    uflake_result_t uflake_event_trace_start(uint32_t max_records);
+    uflake_result_t uflake_event_trace_stop(void);
+    void uflake_event_trace_clear(void);
+    bool uflake_event_trace_is_active(void);
+
+    /**
+     * @brief Export the recording in the UFET binary format
+     *
+     * Layout: header (magic, version, record size, name count, record count,
+     * lost records) | name table (u8 length + bytes per name) | records,
+     * oldest first. Recording is paused for the duration of the export.
+     */
+    uflake_result_t uflake_event_trace_export(event_trace_writer_t writer, void *ctx);
+    uflake_result_t uflake_event_trace_export_file(const char *path); // e.g. "/sd/events.uft"
+    uflake_result_t uflake_event_trace_export_uart(int uart_port);    // UART driver must be installed
+
+    // Hooks used by the event manager (cheap no-ops while not recording)
+    void uflake_event_trace_record(event_trace_kind_t kind, const char *event_name, uint8_t flags,
+                                   size_t data_size, uint32_t subscription_id, uint32_t subscriber_pid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UFLAKE_EVENT_TRACE_H
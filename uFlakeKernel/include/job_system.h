@@ -0,0 +1,75 @@
+#ifndef UFLAKE_JOB_SYSTEM_H
+#define UFLAKE_JOB_SYSTEM_H
+
+#include "../kernel.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// One worker task pinned to each core, each owning a job deque
+#define UFLAKE_JOB_WORKER_STACK_SIZE 4096
+#define UFLAKE_JOB_WORKER_PRIORITY (PROCESS_PRIORITY_NORMAL + 1) // Same FreeRTOS priority as normal processes
+#define UFLAKE_JOB_DEQUE_SIZE 64                                  // Jobs per core; a full deque runs the job inline
+#define UFLAKE_JOB_MAX_CHUNKS 16                                  // parallel_for splits a range into at most this many jobs
+
+    typedef void (*uflake_job_fn_t)(void *arg);
+    typedef void (*uflake_parallel_fn_t)(uint32_t begin, uint32_t end, void *ctx);
+
+    // Completion counter - one per batch of jobs, usually on the submitter's stack
+    typedef struct
+    {
+        uint32_t pending; // Unfinished jobs + 1 until uflake_job_wait() (atomic)
+        SemaphoreHandle_t done;
+        StaticSemaphore_t done_buffer;
+    } uflake_job_counter_t;
+
+    typedef struct
+    {
+        uint32_t jobs_run[portNUM_PROCESSORS]; // By the worker of each core
+        uint32_t jobs_stolen;                  // Taken from the other core's deque
+        uint32_t jobs_helped;                  // Run by a waiting submitter
+        uint32_t jobs_inline;                  // Run inline because a deque was full
+    } uflake_job_stats_t;
+
+    uflake_result_t uflake_job_init(void);
+
+    // A counter may be reused for another batch once uflake_job_wait() returned
+    void uflake_job_counter_init(uflake_job_counter_t *counter);
+
+    /**
+     * @brief Queue a job on the calling core's deque
+     *
+     * The worker of that core runs it, unless the other core's worker is idle
+     * and steals it first. Not callable from ISRs.
+     *
+     * @param counter Completion counter to signal (may be NULL)
+     */
+    uflake_result_t uflake_job_submit(uflake_job_counter_t *counter, uflake_job_fn_t fn, void *arg);
+
+    /**
+     * @brief Wait until every job of the counter has finished
+     *
+     * The caller runs queued jobs itself while it waits, so nested waits from
+     * inside a job cannot deadlock the workers.
+     */
+    void uflake_job_wait(uflake_job_counter_t *counter);
+
+    /**
+     * @brief Run fn over [begin, end) split into chunks of at least grain indices
+     *
+     * Chunks run on both cores; the caller runs one itself and returns when
+     * all are done. Runs inline if the range is smaller than two chunks or the
+     * job system is not up yet. fn must only touch its own index range.
+     */
+    uflake_result_t uflake_job_parallel_for(uint32_t begin, uint32_t end, uint32_t grain,
+                                            uflake_parallel_fn_t fn, void *ctx);
+
+    uflake_result_t uflake_job_get_stats(uflake_job_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UFLAKE_JOB_SYSTEM_H
@@ -0,0 +1,101 @@
+#ifndef UFLAKE_KERNEL_TRACE_H
+#define UFLAKE_KERNEL_TRACE_H
+
+#include "../kernel.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define UFLAKE_KERNEL_TRACE_MAGIC 0x544B4655 // "UFKT" little-endian
+#define UFLAKE_KERNEL_TRACE_VERSION 1
+#define UFLAKE_KERNEL_TRACE_MAX_LABELS 64
+#define UFLAKE_KERNEL_TRACE_LABEL_LEN 24
+#define UFLAKE_KERNEL_TRACE_DEFAULT_RECORDS 1024 // Per core, 16 KB each in internal RAM
+#define UFLAKE_KERNEL_TRACE_SYNC_TICKS 10        // Clock sync record every N ticks per core
+#define UFLAKE_KERNEL_TRACE_NO_LABEL 0xFFFF
+
+    // Trace record kinds. *_BEGIN/*_END pairs become slices in the viewer.
+    typedef enum
+    {
+        KERNEL_TRACE_SYNC = 0,          // arg = low 32 bits of esp_timer_get_time() (clock alignment)
+        KERNEL_TRACE_TASK_SWITCH = 1,   // task = task switched in
+        KERNEL_TRACE_MUTEX_WAIT = 2,    // Blocking on a held mutex, arg = mutex id
+        KERNEL_TRACE_MUTEX_ACQUIRE = 3, // Mutex taken, ends the wait, arg = mutex id
+        KERNEL_TRACE_MUTEX_RELEASE = 4, // Mutex given back or wait timed out, arg = mutex id
+        KERNEL_TRACE_QUEUE_SEND = 5,    // arg = message size
+        KERNEL_TRACE_QUEUE_RECEIVE = 6, // arg = message size
+        KERNEL_TRACE_TIMER_BEGIN = 7,   // Timer callback, arg = timer id
+        KERNEL_TRACE_TIMER_END = 8,
+        KERNEL_TRACE_EVENT_BEGIN = 9,   // Event dispatch to all subscribers, arg = payload size
+        KERNEL_TRACE_EVENT_END = 10,
+        KERNEL_TRACE_SPI_BEGIN = 11,    // SPI transaction on the wire, arg = bytes
+        KERNEL_TRACE_SPI_END = 12,
+        KERNEL_TRACE_FLUSH_BEGIN = 13,  // LVGL display flush, arg = pixels
+        KERNEL_TRACE_FLUSH_END = 14,
+        KERNEL_TRACE_MARK = 15          // User instant marker, arg = caller defined
+    } kernel_trace_kind_t;
+
+    // Record flags
+#define KERNEL_TRACE_FLAG_ISR 0x01 // Recorded from an interrupt handler
+
+    // Binary record - 16 bytes, exported as-is (little-endian). Each core
+    // records into its own ring, timestamped with its own cycle counter.
+    typedef struct __attribute__((packed))
+    {
+        uint32_t ccount;   // CPU cycle counter of the recording core
+        uint8_t kind;      // kernel_trace_kind_t
+        uint8_t flags;     // KERNEL_TRACE_FLAG_*
+        uint16_t label_id; // Index into the exported label table, KERNEL_TRACE_NO_LABEL if none
+        uint32_t task;     // Running task handle (the one switched in for TASK_SWITCH)
+        uint32_t arg;      // Kind specific
+    } uflake_kernel_trace_record_t;
+
+    // Writer used by uflake_kernel_trace_export() - return bytes written
+    typedef size_t (*kernel_trace_writer_t)(const void *data, size_t size, void *ctx);
+
+    /**
+     * @brief Start recording into one ring per core (internal RAM)
+     *
+     * The rings live in internal RAM because context switches are recorded
+     * from code that may run with the flash cache disabled.
+     *
+     * @param records_per_core Ring capacity (0 = UFLAKE_KERNEL_TRACE_DEFAULT_RECORDS); oldest records are overwritten
+     */
+    uflake_result_t uflake_kernel_trace_start(uint32_t records_per_core);
+    uflake_result_t uflake_kernel_trace_stop(void);
+    void uflake_kernel_trace_clear(void);
+    bool uflake_kernel_trace_is_active(void);
+
+    /**
+     * @brief Export the recording in the UFKT binary format
+     *
+     * Layout: header (magic, version, record size, core count, label count,
+     * task count, CPU MHz) | per core: record count, lost records | label
+     * table (u8 length + bytes) | task table (u32 handle, u8 length + bytes)
+     * | records of core 0, core 1, ... oldest first. Recording is paused for
+     * the duration of the export. tools/kernel_trace.py turns the dump into
+     * Chrome trace JSON for chrome://tracing or ui.perfetto.dev.
+     */
+    uflake_result_t uflake_kernel_trace_export(kernel_trace_writer_t writer, void *ctx);
+    uflake_result_t uflake_kernel_trace_export_file(const char *path); // e.g. "/sd/kernel.ufk"
+    uflake_result_t uflake_kernel_trace_export_uart(int uart_port);    // UART driver must be installed
+
+    /**
+     * @brief Record one trace event (cheap no-op while not recording)
+     *
+     * Wait-free and safe from tasks and ISRs on both cores.
+     *
+     * @param label Object name (mutex, queue, event, ...) or NULL; interned on first use
+     */
+    void uflake_kernel_trace_record(kernel_trace_kind_t kind, const char *label, uint32_t arg);
+
+    // FreeRTOS hook, see kernel_trace_hooks.h
+    void uflake_kernel_trace_task_switched_in(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UFLAKE_KERNEL_TRACE_H
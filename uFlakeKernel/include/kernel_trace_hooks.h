@@ -0,0 +1,25 @@
+#ifndef UFLAKE_KERNEL_TRACE_HOOKS_H
+#define UFLAKE_KERNEL_TRACE_HOOKS_H
+
+// Force-included into every translation unit (see the top-level CMakeLists.txt)
+// so that FreeRTOS tasks.c picks up the kernel trace hooks. Keep it free of
+// includes - it is seen before any other header, including by assembly files.
+
+#ifndef __ASSEMBLER__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    void uflake_kernel_trace_task_switched_in(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define traceTASK_SWITCHED_IN() uflake_kernel_trace_task_switched_in()
+
+#endif // __ASSEMBLER__
+
+#endif // UFLAKE_KERNEL_TRACE_HOOKS_H
@@ -8,6 +8,29 @@ extern "C"
 {
 #endif
 
+// Deferred binary logging: uflake_log() only captures the format pointer,
+// timestamp, tag ID and raw arguments; text is produced when entries are
+// read or drained to the console by the log task. 0 = format and print in
+// the caller as before.
+#define UFLAKE_LOG_DEFERRED 1
+#define UFLAKE_LOG_MESSAGE_LEN 128   // Formatted message, including the terminator
+#define UFLAKE_LOG_RING_SIZE 64      // Records per core (152 bytes each), power of two
+// Raw argument bytes per record; %s strings are copied in here. Sized so a
+// single string can fill a whole message. Arguments that still do not fit
+// (long strings after other arguments, or dozens of numbers) are cut and
+// the message ends in "..." - raise this, at 64 x cores bytes a step, if
+// that shows up. At most 255.
+#define UFLAKE_LOG_ARG_BYTES UFLAKE_LOG_MESSAGE_LEN
+#define UFLAKE_LOG_MAX_TAGS 48       // Distinct tags; more are logged as "?"
+#define UFLAKE_LOG_TASK_STACK_SIZE 3072
+#define UFLAKE_LOG_TASK_PRIORITY 1   // Console output runs below every process
+
+// Log streaming (uflake_log_stream_start)
+#define UFLAKE_LOG_STREAM_BATCH 16          // Lines per write
+#define UFLAKE_LOG_STREAM_PERIOD_MS 500     // Longest a line waits before its batch is written
+#define UFLAKE_LOG_STREAM_STACK_SIZE 3072
+#define UFLAKE_LOG_STREAM_PRIORITY 1
+
     typedef enum
     {
         LOG_LEVEL_ERROR = 0,
@@ -22,14 +45,77 @@ extern "C"
         uint32_t timestamp;
         log_level_t level;
         char tag[16];
-        char message[128];
+        char message[UFLAKE_LOG_MESSAGE_LEN];
     } log_entry_t;
 
+    // Read position in the log, one per reader. Readers never block writers or each other.
+    typedef struct
+    {
+        uint32_t pos[portNUM_PROCESSORS];
+        uint32_t dropped; // Records overwritten before this cursor read them, since it was opened
+    } uflake_log_cursor_t;
+
+    typedef struct
+    {
+        log_level_t max_level; // Most verbose level passed, e.g. LOG_LEVEL_WARN = errors and warnings
+        const char *tag;       // Only this tag, NULL = every tag
+    } uflake_log_filter_t;
+
+    // Writer used by uflake_log_stream_start() - return bytes written
+    typedef size_t (*uflake_log_writer_t)(const void *data, size_t size, void *ctx);
+
     uflake_result_t uflake_logger_init(void);
+    // format must be a string literal or otherwise outlive the record (it is stored by pointer)
     void uflake_log(log_level_t level, const char *tag, const char *format, ...);
     uflake_result_t uflake_log_set_level(log_level_t level);
+    // Up to *count of the oldest records still held, in time order
     uflake_result_t uflake_log_get_entries(log_entry_t *entries, size_t *count);
 
+    /**
+     * @brief Open a cursor at the oldest record still held, or at the end
+     *
+     * At the end, the first read returns only what is logged afterwards.
+     */
+    uflake_result_t uflake_log_cursor_init(uflake_log_cursor_t *cursor, bool from_oldest);
+
+    /**
+     * @brief Read entries logged since the cursor, in time order, and advance it
+     *
+     * Only formats what passes the filter (NULL = everything). Records that
+     * writers overwrote before they were read are skipped and counted.
+     *
+     * @param count In: room in entries. Out: entries returned, 0 when caught up
+     * @param dropped Optional, records lost since the previous read
+     */
+    uflake_result_t uflake_log_read(uflake_log_cursor_t *cursor, const uflake_log_filter_t *filter,
+                                    log_entry_t *entries, size_t *count, uint32_t *dropped);
+
+    /**
+     * @brief Print every record not yet written to the console, in the caller
+     *
+     * The log task does this in the background; call it before a reset or
+     * panic so pending lines are not lost.
+     */
+    void uflake_log_flush(void);
+
+    // Records the ring overwrote before the log task printed them
+    uint32_t uflake_log_get_dropped(void);
+
+    /**
+     * @brief Stream log lines to a writer in the background
+     *
+     * A low priority task follows its own cursor from the oldest record
+     * held and writes console-style lines in batches of
+     * UFLAKE_LOG_STREAM_BATCH, at least every UFLAKE_LOG_STREAM_PERIOD_MS.
+     * Gaps are written as a "records dropped" line. One stream at a time.
+     */
+    uflake_result_t uflake_log_stream_start(uflake_log_writer_t writer, void *ctx, const uflake_log_filter_t *filter);
+    uflake_result_t uflake_log_stream_start_uart(int uart_port, const uflake_log_filter_t *filter); // UART driver must be installed
+    uflake_result_t uflake_log_stream_start_file(const char *path, const uflake_log_filter_t *filter); // Appends, e.g. "/sd/system.log"
+
+    // Write what is left, close the file if any and end the stream task
+    void uflake_log_stream_stop(void);
+
 #define UFLAKE_LOGE(tag, format, ...) uflake_log(LOG_LEVEL_ERROR, tag, format, ##__VA_ARGS__)
 #define UFLAKE_LOGW(tag, format, ...) uflake_log(LOG_LEVEL_WARN, tag, format, ##__VA_ARGS__)
 #define UFLAKE_LOGI(tag, format, ...) uflake_log(LOG_LEVEL_INFO, tag, format, ##__VA_ARGS__)
@@ -1,6 +1,14 @@
 #ifndef UFLAKE_MEMORY_MANAGER_H
 #define UFLAKE_MEMORY_MANAGER_H
 
+// Memory types (defined BEFORE kernel.h - other subsystem headers use it)
+typedef enum
+{
+    UFLAKE_MEM_INTERNAL,
+    UFLAKE_MEM_SPIRAM,
+    UFLAKE_MEM_DMA
+} uflake_mem_type_t;
+
 #include "../kernel.h"
 
 #ifdef __cplusplus
@@ -8,14 +16,6 @@ extern "C"
 {
 #endif
 
-    // Memory types
-    typedef enum
-    {
-        UFLAKE_MEM_INTERNAL,
-        UFLAKE_MEM_SPIRAM,
-        UFLAKE_MEM_DMA
-    } uflake_mem_type_t;
-
     // Memory statistics
     typedef struct
     {
@@ -53,6 +53,7 @@ extern "C"
         uint32_t message_count;
         uint32_t owner_pid;
         bool is_public;
+        uint32_t coro_waiters; // Coroutines awaiting this queue (senders wake the coroutine worker)
         struct uflake_msgqueue_node_t *next;
     } uflake_msgqueue_t;
 
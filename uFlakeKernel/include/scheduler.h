@@ -28,10 +28,49 @@ extern "C"
         PROCESS_PRIORITY_CRITICAL = 4
     } process_priority_t;
 
+    // Process core placement (0 = any, so zero-initialized configs float)
+    typedef enum
+    {
+        PROCESS_AFFINITY_ANY = 0,   // Let FreeRTOS run it on either core
+        PROCESS_AFFINITY_CORE0 = 1, // Pin to core 0 (PRO CPU - WiFi/BT stacks)
+        PROCESS_AFFINITY_CORE1 = 2, // Pin to core 1 (APP CPU)
+        PROCESS_AFFINITY_AUTO = 3   // Pin to the less-loaded core at creation (CPU-heavy work)
+    } process_affinity_t;
+
+
+    // Task-local storage slot holding each process task's uflake_process_t
+    // (slot 0 is used by ESP-IDF pthread)
+#define UFLAKE_PROCESS_TLS_INDEX 1
+
+#if configNUM_THREAD_LOCAL_STORAGE_POINTERS <= UFLAKE_PROCESS_TLS_INDEX
+#error "uFlake needs CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS >= 2"
+#endif
 
     // Process entry point function
     typedef void (*process_entry_t)(void *args);
 
+    // One job of a periodic process; return false to stop releasing and exit
+    typedef bool (*periodic_job_t)(void *args);
+
+    // Release state of a periodic process (opaque)
+    typedef struct uflake_periodic_t uflake_periodic_t;
+
+    // Timing of a periodic process. Times are relative to each job's
+    // nominal release (start + n * period), so they include scheduling delay.
+    typedef struct
+    {
+        uint32_t period_us;
+        uint32_t deadline_us;         // Relative deadline
+        uint32_t releases;            // Jobs run
+        uint32_t deadline_misses;     // Jobs that completed after their deadline
+        uint32_t skipped_releases;    // Releases dropped because a job overran its period
+        uint32_t response_last_us;    // Release to completion
+        uint32_t response_max_us;
+        uint32_t response_avg_us;
+        uint32_t jitter_max_us;       // Release to job start (release jitter)
+        uint32_t jitter_avg_us;
+    } uflake_periodic_stats_t;
+
     // Process control block
     struct uflake_process_t
     {
@@ -39,23 +78,117 @@ extern "C"
         char name[32];
         process_state_t state;
         process_priority_t priority;
+        process_affinity_t affinity;
+        int8_t core; // Core the task is pinned to, -1 = either
         TaskHandle_t task_handle;
         void *stack_ptr;
         size_t stack_size;
-        uint32_t cpu_time;
+        uint32_t stack_peak;   // Deepest stack use seen, in bytes (high-water mark)
+        int16_t pool_slot;     // Static pool slot, -1 = heap-allocated
+        uint64_t cpu_time_us;  // CPU time since creation (FreeRTOS run-time stats)
+        uint16_t cpu_permille; // Share of one core over the last sample window
+        uflake_periodic_t *periodic; // Release state of periodic processes, NULL otherwise
         struct uflake_process_t *next;
     };
 
+// Static process pool - stacks and TCBs reserved at boot in internal RAM, so
+// launching and exiting processes does not allocate. A process gets the
+// smallest free class that fits its stack; larger stacks or an exhausted
+// pool fall back to the heap.
+#define UFLAKE_PROCESS_POOL_4K_SLOTS 4
+#define UFLAKE_PROCESS_POOL_8K_SLOTS 2
+#define UFLAKE_PROCESS_POOL_16K_SLOTS 1
+
+#define UFLAKE_STACK_SAMPLE_PERIOD_MS 500 // Stack high-water-mark sampling
+#define UFLAKE_CPU_SAMPLE_PERIOD_MS 1000  // CPU accounting window
+#define UFLAKE_CPU_MAX_TASKS 48           // Tasks tracked per sample
+
+    // One task in a CPU snapshot
+    typedef struct
+    {
+        char name[configMAX_TASK_NAME_LEN];
+        uint32_t pid;          // 0 = not a uFlake process (kernel service, driver, idle)
+        int8_t core;           // Pinned core, -1 = either core
+        uint8_t priority;
+        uint16_t cpu_permille; // Share of one core over the window
+        uint32_t window_us;    // CPU time used during the window
+        uint64_t cpu_time_us;  // Process total since creation (0 for non-process tasks)
+    } uflake_task_load_t;
+
+    // top-like view of the last completed sample window
+    typedef struct
+    {
+        uint32_t window_us;
+        uint16_t core_load_permille[portNUM_PROCESSORS]; // 1000 - idle task share
+        uint32_t task_count;
+        uflake_task_load_t tasks[UFLAKE_CPU_MAX_TASKS]; // Heaviest first
+    } uflake_cpu_snapshot_t;
+
     // Scheduler functions
     uflake_result_t uflake_scheduler_init(void);
     uflake_result_t uflake_process_create(const char *name, process_entry_t entry, void *args,
                                           size_t stack_size, process_priority_t priority, uint32_t *pid);
+
+    /**
+     * @brief Create a process with a core affinity
+     *
+     * PROCESS_AFFINITY_AUTO pins the task to the core with the lower load over
+     * the last CPU sample window (see uflake_scheduler_get_cpu_snapshot), or to
+     * the core with fewer pinned processes before the first window completes.
+     */
+    uflake_result_t uflake_process_create_ex(const char *name, process_entry_t entry, void *args,
+                                             size_t stack_size, process_priority_t priority,
+                                             process_affinity_t affinity, uint32_t *pid);
+
+    /**
+     * @brief Create a process that runs job once every period_us
+     *
+     * Releases are anchored to absolute times (start + n * period_us) like
+     * vTaskDelayUntil, so they never drift, and are timed with an esp_timer
+     * alarm rather than the tick, so periods below one tick work. A job that
+     * overruns its period drops the releases it missed (counted as skipped)
+     * and the next one stays phase-aligned. The job must not use its task's
+     * notification value, which carries the release signal.
+     *
+     * @param deadline_us Relative deadline for each job, 0 = period_us
+     */
+    uflake_result_t uflake_process_create_periodic(const char *name, periodic_job_t job, void *args,
+                                                   uint32_t period_us, uint32_t deadline_us,
+                                                   size_t stack_size, process_priority_t priority,
+                                                   process_affinity_t affinity, uint32_t *pid);
+    uflake_result_t uflake_process_get_periodic_stats(uint32_t pid, uflake_periodic_stats_t *stats);
     uflake_result_t uflake_process_terminate(uint32_t pid);
     uflake_result_t uflake_process_suspend(uint32_t pid);
     uflake_result_t uflake_process_resume(uint32_t pid);
     void uflake_scheduler_tick(void);
+
+    /**
+     * @brief Copy the CPU usage of every task over the last sample window
+     *
+     * Sampled by the kernel loop every UFLAKE_CPU_SAMPLE_PERIOD_MS from the
+     * FreeRTOS run-time counters; requires CONFIG_FREERTOS_USE_TRACE_FACILITY
+     * and CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS.
+     *
+     * @return UFLAKE_ERROR_NOT_FOUND until the first window has completed
+     */
+    uflake_result_t uflake_scheduler_get_cpu_snapshot(uflake_cpu_snapshot_t *snapshot);
     uflake_process_t *uflake_process_get_current(void);
 
+    /**
+     * @brief Peak stack use of a process in bytes
+     *
+     * Takes a fresh high-water-mark sample, so the value is exact even between
+     * the periodic samples of the kernel loop. Call it before the process
+     * exits - its PCB is gone afterwards.
+     */
+    uflake_result_t uflake_process_get_stack_peak(uint32_t pid, uint32_t *peak_bytes);
+
+    // Smallest pool stack class that holds stack_size (stack_size itself if none does)
+    size_t uflake_process_pool_fit(size_t stack_size);
+
+    // Log stack size, peak use and headroom of every process
+    void uflake_scheduler_print_stack_report(void);
+
     /**
      * @brief Yields CPU to other tasks and automatically feeds watchdog
      * 
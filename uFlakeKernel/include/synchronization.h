@@ -8,14 +8,70 @@ extern "C"
 {
 #endif
 
-    // uFlake mutex handle
+// Per-mutex contention profiling in uflake_mutex_lock/unlock
+#define UFLAKE_MUTEX_PROFILING 1
+#define UFLAKE_MUTEX_NAME_LEN 16
+#define UFLAKE_MUTEX_HIST_BUCKETS 6 // <10us, <100us, <1ms, <10ms, <100ms, >=100ms
+
+    // Contention statistics of one mutex. Updated by the lock holder, so a
+    // copy taken while the mutex is busy can be one acquisition behind.
     typedef struct
+    {
+        uint32_t acquisitions;
+        uint32_t contended;   // Acquisitions that had to wait for another holder
+        uint32_t timeouts;    // Lock attempts that gave up
+        uint64_t total_wait_us;
+        uint64_t total_hold_us;
+        uint32_t max_wait_us;
+        uint32_t max_hold_us;
+        uint32_t max_hold_pid; // Process that held it longest (0 = not a uFlake process)
+        uint32_t wait_histogram[UFLAKE_MUTEX_HIST_BUCKETS]; // Contended acquisitions only
+        uint32_t hold_histogram[UFLAKE_MUTEX_HIST_BUCKETS];
+    } uflake_mutex_stats_t;
+
+    // uFlake mutex handle
+    typedef struct uflake_mutex_t
     {
         SemaphoreHandle_t handle;
         uint32_t owner_pid;
         uint32_t lock_count;
+#if UFLAKE_MUTEX_PROFILING
+        char name[UFLAKE_MUTEX_NAME_LEN];
+        int64_t locked_at_us;
+        uflake_mutex_stats_t stats;
+        struct uflake_mutex_t *next; // Contention registry
+#endif
     } uflake_mutex_t;
 
+    // Writer-preferring reader-writer lock. A waiting writer closes the
+    // turnstile, so readers arriving after it queue behind it and a steady
+    // stream of readers cannot starve writers. Not recursive; a reader must
+    // not upgrade to a writer.
+    typedef struct uflake_rwlock_t
+    {
+        SemaphoreHandle_t turnstile;    // Held by a writer from request to unlock
+        SemaphoreHandle_t reader_mutex; // Guards readers
+        SemaphoreHandle_t room_empty;   // Binary - available while nobody is inside
+        uint32_t readers;
+#if UFLAKE_MUTEX_PROFILING
+        char name[UFLAKE_MUTEX_NAME_LEN];
+        int64_t write_locked_at_us;
+        uflake_mutex_stats_t read_stats;  // Updated under reader_mutex; no hold times (readers overlap)
+        uflake_mutex_stats_t write_stats; // Updated by the writer
+        struct uflake_rwlock_t *next;     // Contention registry
+#endif
+    } uflake_rwlock_t;
+
+    // Cross-core spin lock for critical sections of a few microseconds.
+    // Disables interrupts on the calling core while held; never block,
+    // log or call into FreeRTOS while holding it. Usable from ISRs.
+    typedef struct
+    {
+        portMUX_TYPE mux;
+    } uflake_spinlock_t;
+
+#define UFLAKE_SPINLOCK_INITIALIZER {.mux = portMUX_INITIALIZER_UNLOCKED}
+
     // uFlake semaphore handle
     typedef struct
     {
@@ -28,10 +84,52 @@ extern "C"
 
     // Mutex operations
     uflake_result_t uflake_mutex_create(uflake_mutex_t **mutex);
+
+    // Named mutexes show up by name in the contention report
+    uflake_result_t uflake_mutex_create_named(uflake_mutex_t **mutex, const char *name);
     uflake_result_t uflake_mutex_lock(uflake_mutex_t *mutex, uint32_t timeout_ms);
     uflake_result_t uflake_mutex_unlock(uflake_mutex_t *mutex);
     uflake_result_t uflake_mutex_destroy(uflake_mutex_t *mutex);
 
+    // Contention profiling (UFLAKE_MUTEX_PROFILING)
+    uflake_result_t uflake_mutex_get_stats(uflake_mutex_t *mutex, uflake_mutex_stats_t *stats);
+    void uflake_mutex_reset_stats(void);
+
+    /**
+     * @brief Log every registered mutex, most total wait time first
+     *
+     * Shows acquisitions, contention rate, wait and hold times with their
+     * histograms, and which process held the lock longest. Reader-writer
+     * locks are listed with their read and write sides as separate rows.
+     */
+    void uflake_mutex_print_contention(void);
+
+    // Reader-writer lock operations (task context only)
+    uflake_result_t uflake_rwlock_create(uflake_rwlock_t **rwlock);
+    uflake_result_t uflake_rwlock_create_named(uflake_rwlock_t **rwlock, const char *name);
+    uflake_result_t uflake_rwlock_read_lock(uflake_rwlock_t *rwlock, uint32_t timeout_ms);
+    uflake_result_t uflake_rwlock_read_unlock(uflake_rwlock_t *rwlock);
+    uflake_result_t uflake_rwlock_write_lock(uflake_rwlock_t *rwlock, uint32_t timeout_ms);
+    uflake_result_t uflake_rwlock_write_unlock(uflake_rwlock_t *rwlock);
+    uflake_result_t uflake_rwlock_destroy(uflake_rwlock_t *rwlock);
+    uflake_result_t uflake_rwlock_get_stats(uflake_rwlock_t *rwlock, uflake_mutex_stats_t *read_stats,
+                                            uflake_mutex_stats_t *write_stats);
+
+    // Spin lock operations (task and ISR context)
+    void uflake_spinlock_init(uflake_spinlock_t *lock);
+    void uflake_spinlock_lock(uflake_spinlock_t *lock);
+    void uflake_spinlock_unlock(uflake_spinlock_t *lock);
+
+    /**
+     * @brief Microbenchmark of the lock primitives, results go to the log
+     *
+     * Times lock/unlock pairs of uflake_mutex, rwlock (read and write) and
+     * spinlock, first uncontended and then with a helper task on the other
+     * core hammering the same lock. Takes a few hundred ms; run it from a
+     * task with at least 4 KB of stack, not from the kernel loop.
+     */
+    void uflake_sync_benchmark(uint32_t iterations);
+
     // Semaphore operations (ISR-safe)
     uflake_result_t uflake_semaphore_create(uflake_semaphore_t **semaphore, uint32_t initial_count, uint32_t max_count);
     uflake_result_t uflake_semaphore_take(uflake_semaphore_t *semaphore, uint32_t timeout_ms);
@@ -8,25 +8,88 @@ extern "C"
 {
 #endif
 
+// Timer service task - callbacks run here, keep them short
+#define UFLAKE_TIMER_SERVICE_STACK_SIZE 4096
+#define UFLAKE_TIMER_SERVICE_PRIORITY (configMAX_PRIORITIES - 3)
+#define UFLAKE_TIMER_CALLBACK_QUEUE_LEN 32
+#define UFLAKE_TIMER_CALLBACK_BUDGET_US 1000 // Callbacks longer than this are counted as overruns
+
     typedef void (*timer_callback_t)(void *args);
 
+    // What a periodic timer does when it fired too late to hit one or more periods.
+    // Periodic timers stay anchored to their start phase in every case.
+    typedef enum
+    {
+        TIMER_OVERRUN_SKIP = 0, // Drop missed periods, resume on the next phase-aligned deadline (default)
+        TIMER_OVERRUN_CATCH_UP, // Fire once for every missed period, back to back
+        TIMER_OVERRUN_REPORT    // Like SKIP, but log a warning for every overrun
+    } timer_overrun_policy_t;
+
     typedef struct
     {
         uint32_t timer_id;
-        uint32_t interval_ms;
-        uint32_t next_trigger;
+        uint64_t interval_us;
+        int64_t next_trigger_us; // esp_timer_get_time() time base
+        uint32_t slack_us;       // May fire up to this late to share a wakeup
         timer_callback_t callback;
         void *args;
+        timer_overrun_policy_t overrun_policy;
+        uint32_t overrun_count; // Periods missed (skipped or fired late)
         bool is_periodic;
         bool is_active;
     } uflake_timer_t;
 
+    // Timer service statistics
+    typedef struct
+    {
+        uint32_t armed_timers;
+        uint32_t callbacks_run;
+        uint64_t total_runtime_us;
+        uint32_t max_runtime_us;
+        uint32_t max_runtime_timer_id;
+        uint32_t max_latency_us;       // Worst deadline-to-callback delay
+        uint32_t budget_overruns;      // Callbacks over UFLAKE_TIMER_CALLBACK_BUDGET_US
+        uint32_t queue_full_deferrals; // Collections cut short by a full daemon queue
+        uint32_t wakeups;              // Timer service wakeups since boot
+        uint32_t wakeups_per_sec;      // Over the last completed measurement window
+        uint32_t coalesced_timers;     // Timers fired early inside another timer's wakeup
+    } uflake_timer_stats_t;
+
     uflake_result_t uflake_timer_init(void);
     uflake_result_t uflake_timer_create(uint32_t *timer_id, uint32_t interval_ms,
                                         timer_callback_t callback, void *args, bool periodic);
+    uflake_result_t uflake_timer_create_us(uint32_t *timer_id, uint64_t interval_us,
+                                           timer_callback_t callback, void *args, bool periodic);
+
+    /**
+     * @brief Create a timer with wakeup slack
+     *
+     * The timer fires no earlier than its deadline and no later than
+     * deadline + slack_us. Timers whose windows overlap are fired together
+     * from a single timer service wakeup, which lets the CPU stay in light
+     * sleep longer. Periodic timers keep their phase; slack never drifts them.
+     */
+    uflake_result_t uflake_timer_create_ex(uint32_t *timer_id, uint64_t interval_us, uint32_t slack_us,
+                                           timer_callback_t callback, void *args, bool periodic);
     uflake_result_t uflake_timer_start(uint32_t timer_id);
-    uflake_result_t uflake_timer_stop(uint32_t timer_id);
+    uflake_result_t uflake_timer_stop(uint32_t timer_id); // Also cancels a firing already queued for the daemon
+
+    // Waits for a running callback of this timer, so args may be freed on return
+    // (except from the timer's own callback, where the timer is freed after it returns)
     uflake_result_t uflake_timer_delete(uint32_t timer_id);
+    uflake_result_t uflake_timer_set_overrun_policy(uint32_t timer_id, timer_overrun_policy_t policy);
+    uflake_result_t uflake_timer_get_overruns(uint32_t timer_id, uint32_t *overrun_count);
+    uflake_result_t uflake_timer_get_stats(uflake_timer_stats_t *stats);
+
+    /**
+     * @brief Ask the timer service to fire every timer whose deadline has passed
+     *
+     * Timers are driven by the timer service task, which sleeps until the
+     * earliest deadline (esp_timer one-shot alarm). Expired timers are collected
+     * under the timer lock and their callbacks run afterwards with the lock
+     * released, so a callback may start, stop or delete any timer, including
+     * its own. Calling this directly is only needed to flush due timers early.
+     */
     void uflake_timer_process(void);
 
 #ifdef __cplusplus
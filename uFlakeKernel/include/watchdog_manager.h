@@ -32,6 +32,9 @@ extern "C"
     uflake_result_t uflake_watchdog_delete(uint32_t watchdog_id);
     void uflake_watchdog_check_timeouts(void);
 
+    // Ticks until the nearest active watchdog expires (portMAX_DELAY = none)
+    TickType_t uflake_watchdog_next_wakeup(void);
+
 #ifdef __cplusplus
 }
 #endif
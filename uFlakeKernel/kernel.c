@@ -1,9 +1,11 @@
 #include "kernel.h"
+#include "coroutine.h"
 #include "esp_log.h"
 #include "esp_system.h"
 #include "esp_heap_caps.h"
 #include "esp_timer.h"
 #include "esp_task_wdt.h"
+#include "esp_attr.h"
 #include "rom/ets_sys.h"
 
 static const char *TAG = "KERNEL";
@@ -40,20 +42,21 @@ static void kernel_task(void *pvParameters)
         ESP_LOGI(TAG, "Kernel subscribed to hardware watchdog (exclusive)");
     }
 
-    uint32_t loop_count = 0;
+    TickType_t last_scheduler_tick = xTaskGetTickCount();
 
     // Main kernel loop - equivalent to OS scheduler main loop
     while (g_kernel.state == KERNEL_STATE_RUNNING)
     {
-        // Update tick count
-        g_kernel.tick_count++;
-        loop_count++;
+        // Loop passes come in bursts on every notify - not a time base
+        g_kernel.loop_count++;
 
-        // Run scheduler
-        uflake_scheduler_tick();
-
-        // Process timer callbacks
-        uflake_timer_process();
+        // Run scheduler housekeeping at its own pace, not on every publish wakeup
+        TickType_t now = xTaskGetTickCount();
+        if (now - last_scheduler_tick >= pdMS_TO_TICKS(UFLAKE_KERNEL_SCHEDULER_PERIOD_MS))
+        {
+            last_scheduler_tick = now;
+            uflake_scheduler_tick();
+        }
 
         // Process message queues
         uflake_messagequeue_process();
@@ -70,8 +73,16 @@ static void kernel_task(void *pvParameters)
         // Check for panic conditions
         uflake_panic_check();
 
-        // Small delay to yield CPU
-        vTaskDelay(pdMS_TO_TICKS(100)); // 100ms delay
+        // Sleep until a subsystem queues work or the nearest deadline is due
+        TickType_t wait = pdMS_TO_TICKS(UFLAKE_KERNEL_MAX_SLEEP_MS);
+        TickType_t next = uflake_event_next_wakeup();
+        if (next < wait)
+            wait = next;
+        next = uflake_watchdog_next_wakeup();
+        if (next < wait)
+            wait = next;
+
+        ulTaskNotifyTake(pdTRUE, wait);
     }
 
     ESP_LOGE(TAG, "Kernel loop exited! State=%d", g_kernel.state);
@@ -159,6 +170,13 @@ uflake_result_t uflake_kernel_init(void)
         return UFLAKE_ERROR;
     }
 
+    ESP_LOGI(TAG, "Initializing job system...");
+    if (uflake_job_init() != UFLAKE_OK)
+    {
+        ESP_LOGE(TAG, "Job system initialization failed");
+        return UFLAKE_ERROR;
+    }
+
     ESP_LOGI(TAG, "Initializing message queue system...");
     if (uflake_messagequeue_init() != UFLAKE_OK)
     {
@@ -180,6 +198,13 @@ uflake_result_t uflake_kernel_init(void)
         return UFLAKE_ERROR;
     }
 
+    ESP_LOGI(TAG, "Initializing coroutine worker...");
+    if (uflake_coro_init() != UFLAKE_OK)
+    {
+        ESP_LOGE(TAG, "Coroutine worker initialization failed");
+        return UFLAKE_ERROR;
+    }
+
     ESP_LOGI(TAG, "Initializing resource manager...");
     if (uflake_resource_init() != UFLAKE_OK)
     {
@@ -256,9 +281,33 @@ kernel_state_t uflake_kernel_get_state(void)
     return g_kernel.state;
 }
 
-uint32_t uflake_kernel_get_tick_count(void)
+uint32_t IRAM_ATTR uflake_kernel_get_tick_count(void)
+{
+    return uflake_kernel_is_in_isr() ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
+}
+
+void uflake_kernel_notify(void)
 {
-    return g_kernel.tick_count;
+    if (!g_kernel.kernel_task)
+        return;
+
+    if (uflake_kernel_is_in_isr())
+    {
+        uflake_kernel_notify_from_isr();
+        return;
+    }
+
+    xTaskNotifyGive(g_kernel.kernel_task);
+}
+
+void IRAM_ATTR uflake_kernel_notify_from_isr(void)
+{
+    if (!g_kernel.kernel_task)
+        return;
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(g_kernel.kernel_task, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 // Hardware timer-based delay functions
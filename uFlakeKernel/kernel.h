@@ -26,6 +26,7 @@ extern "C"
     // Forward declarations (BEFORE includes to break circular deps)
     typedef struct uflake_process_t uflake_process_t;
     typedef struct uflake_thread_t uflake_thread_t;
+    typedef struct uflake_buffer_t uflake_buffer_t;
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -46,6 +47,9 @@ extern "C"
 #include "message_queue.h"
 #include "watchdog_manager.h"
 #include "event_manager.h"
+#include "event_trace.h"
+#include "kernel_trace.h"
+#include "job_system.h"
 #include "resource_manager.h"
 #include "hw_auth.h"
 
@@ -54,6 +58,8 @@ extern "C"
 #define UFLAKE_MAX_THREADS_PER_PROCESS 8
 #define UFLAKE_KERNEL_STACK_SIZE 4096
 #define UFLAKE_KERNEL_PRIORITY 24
+#define UFLAKE_KERNEL_MAX_SLEEP_MS 1000       // Idle wakeup for housekeeping / hardware WDT feed
+#define UFLAKE_KERNEL_SCHEDULER_PERIOD_MS 100 // Scheduler housekeeping at most this often
 
     // Kernel state
     typedef enum
@@ -68,7 +74,7 @@ extern "C"
     typedef struct
     {
         kernel_state_t state;
-        uint32_t tick_count;
+        uint32_t loop_count; // Kernel loop passes
         uflake_process_t *current_process;
         TaskHandle_t kernel_task;
         SemaphoreHandle_t kernel_mutex;
@@ -79,7 +85,13 @@ extern "C"
     uflake_result_t uflake_kernel_start(void);
     uflake_result_t uflake_kernel_shutdown(void);
     kernel_state_t uflake_kernel_get_state(void);
-    uint32_t uflake_kernel_get_tick_count(void);
+    uint32_t uflake_kernel_get_tick_count(void); // FreeRTOS ticks since boot, ISR-safe
+
+    // Wake the kernel task after queueing work for it. The kernel loop sleeps
+    // until notified or until the nearest subsystem deadline, capped at
+    // UFLAKE_KERNEL_MAX_SLEEP_MS so housekeeping and the hardware WDT still run.
+    void uflake_kernel_notify(void);
+    void uflake_kernel_notify_from_isr(void);
 
     // Kernel delay functions (hardware timer based)
     void uflake_kernel_delay(uint32_t ticks);
@@ -19,6 +19,11 @@ uflake_result_t uflake_buffer_init(void)
 }
 
 uflake_result_t uflake_buffer_create(uflake_buffer_t **buffer, size_t capacity)
+{
+    return uflake_buffer_create_in(buffer, capacity, UFLAKE_MEM_INTERNAL);
+}
+
+uflake_result_t uflake_buffer_create_in(uflake_buffer_t **buffer, size_t capacity, uflake_mem_type_t mem_type)
 {
     if (!buffer || capacity == 0)
         return UFLAKE_ERROR_INVALID_PARAM;
@@ -32,7 +37,7 @@ uflake_result_t uflake_buffer_create(uflake_buffer_t **buffer, size_t capacity)
         return UFLAKE_ERROR_MEMORY;
     }
 
-    new_buffer->data = uflake_malloc(capacity, UFLAKE_MEM_INTERNAL);
+    new_buffer->data = uflake_malloc(capacity, mem_type);
     if (!new_buffer->data)
     {
         uflake_free(new_buffer);
@@ -53,6 +58,25 @@ uflake_result_t uflake_buffer_create(uflake_buffer_t **buffer, size_t capacity)
     return UFLAKE_OK;
 }
 
+uflake_result_t uflake_buffer_retain(uflake_buffer_t *buffer)
+{
+    if (!buffer)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    xSemaphoreTake(buffer_mutex, portMAX_DELAY);
+
+    if (!buffer->is_allocated || buffer->ref_count == 0)
+    {
+        xSemaphoreGive(buffer_mutex);
+        return UFLAKE_ERROR;
+    }
+
+    buffer->ref_count++;
+
+    xSemaphoreGive(buffer_mutex);
+    return UFLAKE_OK;
+}
+
 uflake_result_t uflake_buffer_write(uflake_buffer_t *buffer, const void *data, size_t size)
 {
     if (!buffer || !data || size == 0)
@@ -0,0 +1,440 @@
+#include "coroutine.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "CORO";
+
+// Coroutines live on one list; creators push at the head, and only the
+// worker unlinks, so the worker can walk the list without holding the lock
+// while a coroutine body runs. coro_mutex guards the wait state, which the
+// event callback (kernel task) updates.
+static uflake_coro_t *coro_list = NULL;
+static SemaphoreHandle_t coro_mutex = NULL;
+static TaskHandle_t coro_worker = NULL;
+static esp_timer_handle_t coro_alarm = NULL; // Earliest timer / timeout deadline
+static uint32_t next_coro_id = 1;
+
+// Event names the worker subscribed to - touched by the worker only
+static char coro_events[UFLAKE_CORO_MAX_EVENTS][UFLAKE_MAX_EVENT_NAME];
+static uint32_t coro_event_count = 0;
+
+static const char *const coro_wait_names[] = {"ready", "timer", "queue", "event"};
+
+static void coro_release_event(uflake_coro_t *coro)
+{
+    if (coro->has_event && coro->event.buffer)
+    {
+        uflake_buffer_destroy(coro->event.buffer);
+    }
+    coro->has_event = false;
+}
+
+// Leave the current wait; called with coro_mutex held
+static void coro_end_wait(uflake_coro_t *coro, uflake_result_t result)
+{
+    if (coro->wait == CORO_WAIT_QUEUE && coro->queue)
+    {
+        __atomic_fetch_sub(&coro->queue->coro_waiters, 1, __ATOMIC_RELAXED);
+        coro->queue = NULL;
+    }
+
+    coro->wait = CORO_WAIT_READY;
+    coro->wait_result = result;
+    coro->deadline_us = 0;
+}
+
+static int64_t coro_deadline(uint32_t timeout_ms)
+{
+    if (timeout_ms == UFLAKE_CORO_FOREVER)
+        return 0;
+
+    return esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+}
+
+static void coro_unlink_and_free(uflake_coro_t *coro)
+{
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    coro_end_wait(coro, UFLAKE_OK);
+
+    uflake_coro_t **link = &coro_list;
+    while (*link && *link != coro)
+    {
+        link = &(*link)->next;
+    }
+    if (*link)
+    {
+        *link = coro->next;
+    }
+    xSemaphoreGive(coro_mutex);
+
+    coro_release_event(coro);
+    ESP_LOGD(TAG, "Coroutine %d '%s' finished", (int)coro->id, coro->name);
+    uflake_free(coro);
+}
+
+// Subscribed once per event name; wakes every coroutine awaiting that name
+static void coro_event_cb(const void *event_data)
+{
+    const uflake_event_t *event = (const uflake_event_t *)event_data;
+    bool woke = false;
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    for (uflake_coro_t *coro = coro_list; coro; coro = coro->next)
+    {
+        if (coro->wait != CORO_WAIT_EVENT || coro->cancelled || strcmp(coro->event_name, event->name) != 0)
+            continue;
+
+        coro->event = *event;
+        if (event->buffer)
+        {
+            uflake_buffer_retain(event->buffer);
+        }
+        coro->has_event = true;
+        coro_end_wait(coro, UFLAKE_OK);
+        woke = true;
+    }
+    xSemaphoreGive(coro_mutex);
+
+    if (woke)
+    {
+        uflake_coro_notify();
+    }
+}
+
+static void coro_alarm_cb(void *arg)
+{
+    uflake_coro_notify();
+}
+
+// Decide whether a coroutine can resume now, ending its wait if so
+static bool coro_poll(uflake_coro_t *coro, int64_t now_us)
+{
+    bool runnable = false;
+
+    // Receive under coro_mutex so uflake_coro_queue_destroyed() cannot free the queue meanwhile
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    if (coro->wait == CORO_WAIT_QUEUE &&
+        uflake_msgqueue_receive(coro->queue, coro->message, 0) == UFLAKE_OK)
+    {
+        coro_end_wait(coro, UFLAKE_OK);
+        runnable = true;
+    }
+    else if (coro->wait == CORO_WAIT_READY)
+    {
+        runnable = true;
+    }
+    else if (coro->deadline_us != 0 && now_us >= coro->deadline_us)
+    {
+        // A timer wait completes, any other wait times out
+        coro_end_wait(coro, (coro->wait == CORO_WAIT_TIMER) ? UFLAKE_OK : UFLAKE_ERROR_TIMEOUT);
+        runnable = true;
+    }
+    xSemaphoreGive(coro_mutex);
+
+    return runnable;
+}
+
+// Resume every runnable coroutine once; returns whether any ran
+static bool coro_run_pass(int64_t *next_deadline_us)
+{
+    bool ran = false;
+    int64_t now_us = esp_timer_get_time();
+
+    *next_deadline_us = 0;
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    uflake_coro_t *coro = coro_list;
+    xSemaphoreGive(coro_mutex);
+
+    while (coro)
+    {
+        uflake_coro_t *next = coro->next;
+
+        if (coro->cancelled)
+        {
+            coro_unlink_and_free(coro);
+        }
+        else if (coro_poll(coro, now_us))
+        {
+            coro->resumes++;
+            uflake_coro_status_t status = coro->fn(coro, coro->ctx);
+            ran = true;
+
+            if (status == UFLAKE_CORO_DONE || coro->cancelled)
+            {
+                coro_unlink_and_free(coro);
+            }
+        }
+        else if (coro->deadline_us != 0 &&
+                 (*next_deadline_us == 0 || coro->deadline_us < *next_deadline_us))
+        {
+            *next_deadline_us = coro->deadline_us;
+        }
+
+        // A body may have pushed new coroutines at the head - they run next pass
+        coro = next;
+    }
+
+    return ran;
+}
+
+static void coro_worker_fn(void *args)
+{
+    ESP_LOGI(TAG, "Coroutine worker running");
+
+    while (true)
+    {
+        int64_t next_deadline_us;
+
+        // Keep going while bodies yield; let same-priority tasks in between passes
+        while (coro_run_pass(&next_deadline_us))
+        {
+            taskYIELD();
+        }
+
+        if (next_deadline_us != 0)
+        {
+            int64_t delay_us = next_deadline_us - esp_timer_get_time();
+            esp_timer_stop(coro_alarm);
+            esp_timer_start_once(coro_alarm, (uint64_t)(delay_us > 0 ? delay_us : 1));
+        }
+
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+uflake_result_t uflake_coro_init(void)
+{
+    coro_mutex = xSemaphoreCreateMutex();
+    if (!coro_mutex)
+    {
+        ESP_LOGE(TAG, "Failed to create coroutine mutex");
+        return UFLAKE_ERROR_MEMORY;
+    }
+
+    const esp_timer_create_args_t alarm_args = {
+        .callback = coro_alarm_cb,
+        .arg = NULL,
+        .name = "uflake_coro"};
+
+    if (esp_timer_create(&alarm_args, &coro_alarm) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to create coroutine alarm");
+        return UFLAKE_ERROR;
+    }
+
+    if (xTaskCreate(coro_worker_fn, "uFlake_Coro", UFLAKE_CORO_WORKER_STACK_SIZE, NULL,
+                    UFLAKE_CORO_WORKER_PRIORITY, &coro_worker) != pdPASS)
+    {
+        ESP_LOGE(TAG, "Failed to create coroutine worker");
+        return UFLAKE_ERROR_MEMORY;
+    }
+
+    ESP_LOGI(TAG, "Coroutine system initialized");
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_coro_create(const char *name, uflake_coro_fn_t fn, void *ctx, uint32_t *coro_id)
+{
+    if (!name || !fn)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    if (!coro_worker)
+        return UFLAKE_ERROR;
+
+    uflake_coro_t *coro = (uflake_coro_t *)uflake_malloc(sizeof(uflake_coro_t), UFLAKE_MEM_INTERNAL);
+    if (!coro)
+        return UFLAKE_ERROR_MEMORY;
+
+    memset(coro, 0, sizeof(uflake_coro_t));
+    strncpy(coro->name, name, sizeof(coro->name) - 1);
+    coro->fn = fn;
+    coro->ctx = ctx;
+    coro->wait = CORO_WAIT_READY;
+    coro->wait_result = UFLAKE_OK;
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    coro->id = next_coro_id++;
+    coro->next = coro_list;
+    coro_list = coro;
+    xSemaphoreGive(coro_mutex);
+
+    if (coro_id)
+        *coro_id = coro->id;
+
+    uflake_coro_notify();
+    ESP_LOGD(TAG, "Created coroutine %d '%s'", (int)coro->id, coro->name);
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_coro_cancel(uint32_t coro_id)
+{
+    uflake_result_t result = UFLAKE_ERROR_NOT_FOUND;
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    for (uflake_coro_t *coro = coro_list; coro; coro = coro->next)
+    {
+        if (coro->id == coro_id)
+        {
+            coro->cancelled = true;
+            result = UFLAKE_OK;
+            break;
+        }
+    }
+    xSemaphoreGive(coro_mutex);
+
+    if (result == UFLAKE_OK)
+    {
+        uflake_coro_notify();
+    }
+    return result;
+}
+
+void uflake_coro_notify(void)
+{
+    if (coro_worker)
+    {
+        xTaskNotifyGive(coro_worker);
+    }
+}
+
+void uflake_coro_notify_from_isr(BaseType_t *higher_priority_task_woken)
+{
+    if (coro_worker)
+    {
+        vTaskNotifyGiveFromISR(coro_worker, higher_priority_task_woken);
+    }
+}
+
+void uflake_coro_queue_destroyed(uflake_msgqueue_t *queue)
+{
+    if (!coro_mutex || !queue)
+        return;
+
+    bool woke = false;
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    for (uflake_coro_t *coro = coro_list; coro; coro = coro->next)
+    {
+        if (coro->wait == CORO_WAIT_QUEUE && coro->queue == queue)
+        {
+            coro_end_wait(coro, UFLAKE_ERROR_NOT_FOUND);
+            woke = true;
+        }
+    }
+    xSemaphoreGive(coro_mutex);
+
+    if (woke)
+    {
+        uflake_coro_notify();
+    }
+}
+
+void uflake_coro_wait_ready(uflake_coro_t *coro)
+{
+    coro_release_event(coro);
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    coro_end_wait(coro, UFLAKE_OK);
+    xSemaphoreGive(coro_mutex);
+}
+
+void uflake_coro_wait_timer(uflake_coro_t *coro, uint32_t delay_ms)
+{
+    coro_release_event(coro);
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    coro_end_wait(coro, UFLAKE_OK);
+    coro->wait = CORO_WAIT_TIMER;
+    coro->deadline_us = esp_timer_get_time() + (int64_t)delay_ms * 1000;
+    xSemaphoreGive(coro_mutex);
+}
+
+void uflake_coro_wait_queue(uflake_coro_t *coro, uflake_msgqueue_t *queue, uflake_message_t *message,
+                            uint32_t timeout_ms)
+{
+    coro_release_event(coro);
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    coro_end_wait(coro, UFLAKE_OK);
+    if (!queue || !message)
+    {
+        coro->wait_result = UFLAKE_ERROR_INVALID_PARAM;
+        xSemaphoreGive(coro_mutex);
+        return;
+    }
+
+    // Senders wake the worker while coro_waiters is non-zero
+    __atomic_fetch_add(&queue->coro_waiters, 1, __ATOMIC_RELAXED);
+    coro->queue = queue;
+    coro->message = message;
+    coro->wait = CORO_WAIT_QUEUE;
+    coro->deadline_us = coro_deadline(timeout_ms);
+    xSemaphoreGive(coro_mutex);
+}
+
+void uflake_coro_wait_event(uflake_coro_t *coro, const char *event_name, uint32_t timeout_ms)
+{
+    coro_release_event(coro);
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    coro_end_wait(coro, UFLAKE_OK);
+    xSemaphoreGive(coro_mutex);
+
+    if (!event_name)
+    {
+        coro->wait_result = UFLAKE_ERROR_INVALID_PARAM;
+        return;
+    }
+
+    // Subscribe outside coro_mutex - the event callback takes it under the event lock
+    bool subscribed = false;
+    for (uint32_t i = 0; i < coro_event_count && !subscribed; i++)
+    {
+        subscribed = (strncmp(coro_events[i], event_name, UFLAKE_MAX_EVENT_NAME) == 0);
+    }
+
+    if (!subscribed)
+    {
+        uint32_t subscription_id;
+        if (coro_event_count >= UFLAKE_CORO_MAX_EVENTS ||
+            uflake_event_subscribe(event_name, coro_event_cb, &subscription_id) != UFLAKE_OK)
+        {
+            ESP_LOGE(TAG, "Coroutine '%s' cannot await event '%s'", coro->name, event_name);
+            coro->wait_result = UFLAKE_ERROR;
+            return;
+        }
+
+        strncpy(coro_events[coro_event_count], event_name, UFLAKE_MAX_EVENT_NAME - 1);
+        coro_events[coro_event_count][UFLAKE_MAX_EVENT_NAME - 1] = '\0';
+        coro_event_count++;
+    }
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    strncpy(coro->event_name, event_name, sizeof(coro->event_name) - 1);
+    coro->event_name[sizeof(coro->event_name) - 1] = '\0';
+    coro->wait = CORO_WAIT_EVENT;
+    coro->deadline_us = coro_deadline(timeout_ms);
+    xSemaphoreGive(coro_mutex);
+}
+
+void uflake_coro_print_status(void)
+{
+    int64_t now_us = esp_timer_get_time();
+    uint32_t count = 0;
+
+    ESP_LOGI(TAG, "=== Coroutines ===");
+
+    xSemaphoreTake(coro_mutex, portMAX_DELAY);
+    for (uflake_coro_t *coro = coro_list; coro; coro = coro->next)
+    {
+        int32_t due_ms = coro->deadline_us ? (int32_t)((coro->deadline_us - now_us) / 1000) : -1;
+        ESP_LOGI(TAG, "%3d %-16s %-6s resumes: %6lu due: %ld ms%s", (int)coro->id, coro->name,
+                 coro_wait_names[coro->wait], (unsigned long)coro->resumes, (long)due_ms,
+                 coro->cancelled ? " (cancelled)" : "");
+        count++;
+    }
+    xSemaphoreGive(coro_mutex);
+
+    ESP_LOGI(TAG, "%lu coroutines, %u bytes each", (unsigned long)count, (unsigned)sizeof(uflake_coro_t));
+}
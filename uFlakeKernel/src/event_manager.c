@@ -1,6 +1,8 @@
 #include "event_manager.h"
 #include "memory_manager.h"
 #include "esp_log.h"
+#include "esp_attr.h"
+#include <stdatomic.h>
 
 static const char *TAG = "EVENT_MGR";
 
@@ -10,14 +12,62 @@ typedef struct subscription_node_t
     struct subscription_node_t *next;
 } subscription_node_t;
 
+// Publish policy slot - holds the latest payload for a policed event name
+typedef struct policy_node_t
+{
+    char event_name[UFLAKE_MAX_EVENT_NAME];
+    event_policy_t policy;
+    uint32_t param_ticks;
+    uflake_event_t latest;
+    bool pending;
+    uint32_t last_publish_tick;
+    uint32_t last_dispatch_tick;
+    uint32_t flush_pass;
+    struct policy_node_t *next;
+} policy_node_t;
+
 static subscription_node_t *subscription_list = NULL;
 // static uflake_event_t *pending_events = NULL;
 static uint32_t next_subscription_id = 1;
 static SemaphoreHandle_t event_mutex = NULL;
 static QueueHandle_t event_queue = NULL;
 
+// Separate lock so callbacks (run under event_mutex) can still publish
+static policy_node_t *policy_list = NULL;
+static SemaphoreHandle_t policy_mutex = NULL;
+
 #define MAX_PENDING_EVENTS 50
 
+// ISR event ring - bounded MPMC sequence ring (producers: ISRs on both cores,
+// consumer: kernel task). A slot is free for position p when seq == p and
+// holds a published event when seq == p + 1.
+typedef struct
+{
+    atomic_uint seq;
+    uflake_event_t event;
+} isr_event_slot_t;
+
+#define ISR_EVENT_RING_MASK (UFLAKE_ISR_EVENT_SLOTS - 1)
+
+static isr_event_slot_t isr_event_ring[UFLAKE_ISR_EVENT_SLOTS];
+static atomic_uint isr_enqueue_pos = 0;
+static uint32_t isr_dequeue_pos = 0;
+static atomic_uint isr_events_dropped = 0;
+
+static policy_node_t *find_policy(const char *event_name)
+{
+    policy_node_t *node = policy_list;
+    while (node)
+    {
+        if (strcmp(node->event_name, event_name) == 0)
+        {
+            return node;
+        }
+        node = node->next;
+    }
+    return NULL;
+}
+
 uflake_result_t uflake_event_init(void)
 {
     event_mutex = xSemaphoreCreateMutex();
@@ -27,6 +77,18 @@ uflake_result_t uflake_event_init(void)
         return UFLAKE_ERROR_MEMORY;
     }
 
+    policy_mutex = xSemaphoreCreateMutex();
+    if (!policy_mutex)
+    {
+        ESP_LOGE(TAG, "Failed to create event policy mutex");
+        return UFLAKE_ERROR_MEMORY;
+    }
+
+    for (uint32_t i = 0; i < UFLAKE_ISR_EVENT_SLOTS; i++)
+    {
+        atomic_store_explicit(&isr_event_ring[i].seq, i, memory_order_relaxed);
+    }
+
     event_queue = xQueueCreate(MAX_PENDING_EVENTS, sizeof(uflake_event_t));
     if (!event_queue)
     {
@@ -38,12 +100,90 @@ uflake_result_t uflake_event_init(void)
     return UFLAKE_OK;
 }
 
+// Store an event in its policy slot if the name is policed.
+// Returns false if the event has no policy and must be queued/dispatched.
+static bool event_store_policed(const uflake_event_t *event)
+{
+    xSemaphoreTake(policy_mutex, portMAX_DELAY);
+    policy_node_t *policy = find_policy(event->name);
+    if (!policy)
+    {
+        xSemaphoreGive(policy_mutex);
+        return false;
+    }
+
+    // Newer payload replaces the pending one - drop its buffer reference
+    if (policy->pending && policy->latest.buffer)
+    {
+        uflake_buffer_destroy(policy->latest.buffer);
+    }
+
+    policy->latest = *event;
+    policy->pending = true;
+    policy->last_publish_tick = xTaskGetTickCount();
+    xSemaphoreGive(policy_mutex);
+
+    // The slot's deadline may be earlier than the kernel's current sleep
+    uflake_kernel_notify();
+    return true;
+}
+
+static inline uint8_t event_trace_flags(const uflake_event_t *event)
+{
+    return event->buffer ? EVENT_TRACE_FLAG_BUFFER : 0;
+}
+
+static inline size_t event_payload_size(const uflake_event_t *event)
+{
+    return event->buffer ? event->buffer->size : event->data_size;
+}
+
+static uflake_result_t event_submit(const uflake_event_t *event)
+{
+    // Policed events only overwrite their slot - never block the publisher
+    if (event_store_policed(event))
+    {
+        uflake_event_trace_record(EVENT_TRACE_PUBLISH, event->name,
+                                  event_trace_flags(event) | EVENT_TRACE_FLAG_POLICED,
+                                  event_payload_size(event), 0, 0);
+        ESP_LOGV(TAG, "Policed event stored: %s", event->name);
+        return UFLAKE_OK;
+    }
+
+    uflake_event_trace_record(EVENT_TRACE_PUBLISH, event->name, event_trace_flags(event),
+                              event_payload_size(event), 0, 0);
+
+    // Add to event queue for processing
+    if (xQueueSend(event_queue, event, pdMS_TO_TICKS(100)) != pdTRUE)
+    {
+        uflake_event_trace_record(EVENT_TRACE_DROP, event->name, event_trace_flags(event),
+                                  event_payload_size(event), 0, 0);
+        ESP_LOGW(TAG, "Failed to queue event: %s", event->name);
+        if (event->buffer)
+        {
+            uflake_buffer_destroy(event->buffer);
+        }
+        return UFLAKE_ERROR_TIMEOUT;
+    }
+
+    uflake_kernel_notify();
+
+    ESP_LOGI(TAG, "Published event: %s, type: %d", event->name, event->type);
+    return UFLAKE_OK;
+}
+
 uflake_result_t uflake_event_publish(const char *event_name, event_type_t type,
                                      const void *data, size_t data_size)
 {
     if (!event_name)
         return UFLAKE_ERROR_INVALID_PARAM;
 
+    //  ISR-SAFE: Auto-detect context
+    if (uflake_kernel_is_in_isr())
+    {
+        return uflake_event_publish_from_isr(event_name, type, data, data_size);
+    }
+
     uflake_event_t event = {0};
     strncpy(event.name, event_name, sizeof(event.name) - 1);
     event.name[sizeof(event.name) - 1] = '\0';
@@ -56,14 +196,96 @@ uflake_result_t uflake_event_publish(const char *event_name, event_type_t type,
         memcpy(event.data, data, event.data_size);
     }
 
-    // Add to event queue for processing
-    if (xQueueSend(event_queue, &event, pdMS_TO_TICKS(100)) != pdTRUE)
+    return event_submit(&event);
+}
+
+uflake_result_t uflake_event_publish_buffer(const char *event_name, event_type_t type,
+                                            uflake_buffer_t *buffer)
+{
+    if (!event_name || !buffer)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    // Buffer refcounting takes a mutex - not possible from an ISR
+    if (uflake_kernel_is_in_isr())
     {
-        ESP_LOGW(TAG, "Failed to queue event: %s", event_name);
-        return UFLAKE_ERROR_TIMEOUT;
+        return UFLAKE_ERROR;
+    }
+
+    // The event owns one reference until the last subscriber has run
+    if (uflake_buffer_retain(buffer) != UFLAKE_OK)
+    {
+        return UFLAKE_ERROR_INVALID_PARAM;
+    }
+
+    uflake_event_t event = {0};
+    strncpy(event.name, event_name, sizeof(event.name) - 1);
+    event.name[sizeof(event.name) - 1] = '\0';
+    event.type = type;
+    event.timestamp = uflake_kernel_get_tick_count();
+    event.buffer = buffer;
+
+    return event_submit(&event);
+}
+
+uflake_result_t IRAM_ATTR uflake_event_publish_from_isr(const char *event_name, event_type_t type,
+                                                       const void *data, size_t data_size)
+{
+    if (!event_name)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    // Claim a slot without locks - retry only if another ISR won the race
+    unsigned pos = atomic_load_explicit(&isr_enqueue_pos, memory_order_relaxed);
+    isr_event_slot_t *slot;
+    while (true)
+    {
+        slot = &isr_event_ring[pos & ISR_EVENT_RING_MASK];
+        unsigned seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int diff = (int)(seq - pos);
+
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&isr_enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Ring full - kernel task has not drained it yet
+            atomic_fetch_add_explicit(&isr_events_dropped, 1, memory_order_relaxed);
+            uflake_event_trace_record(EVENT_TRACE_DROP, event_name, 0, data_size, 0, 0);
+            return UFLAKE_ERROR_MEMORY;
+        }
+        else
+        {
+            pos = atomic_load_explicit(&isr_enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    uflake_event_t *event = &slot->event;
+    size_t i = 0;
+    for (; i < sizeof(event->name) - 1 && event_name[i]; i++)
+    {
+        event->name[i] = event_name[i];
+    }
+    event->name[i] = '\0';
+    event->type = type;
+    event->timestamp = uflake_kernel_get_tick_count(); // Same time base as the task path
+    event->buffer = NULL;
+    event->data_size = 0;
+
+    if (data && data_size > 0)
+    {
+        event->data_size = (data_size > UFLAKE_MAX_EVENT_DATA) ? UFLAKE_MAX_EVENT_DATA : data_size;
+        memcpy(event->data, data, event->data_size);
     }
 
-    ESP_LOGI(TAG, "Published event: %s, type: %d", event_name, type);
+    // Publish the slot to the consumer
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    uflake_event_trace_record(EVENT_TRACE_PUBLISH_ISR, event_name, 0, data_size, 0, 0);
+
+    uflake_kernel_notify_from_isr();
     return UFLAKE_OK;
 }
 
@@ -134,37 +356,296 @@ uflake_result_t uflake_event_unsubscribe(uint32_t subscription_id)
     return UFLAKE_ERROR_NOT_FOUND;
 }
 
-void uflake_event_process(void)
+static void event_dispatch(const uflake_event_t *event)
+{
+    ESP_LOGD(TAG, "Processing event: %s", event->name);
+    uflake_event_trace_record(EVENT_TRACE_DISPATCH, event->name, event_trace_flags(event),
+                              event_payload_size(event), 0, 0);
+
+    // Use timeout to prevent deadlock
+    if (xSemaphoreTake(event_mutex, pdMS_TO_TICKS(10)) != pdTRUE)
+    {
+        if (event->buffer)
+        {
+            uflake_buffer_destroy(event->buffer);
+        }
+        return;
+    }
+
+    uflake_kernel_trace_record(KERNEL_TRACE_EVENT_BEGIN, event->name, (uint32_t)event_payload_size(event));
+
+    subscription_node_t *current = subscription_list;
+    uint32_t callback_count = 0;
+
+    while (current)
+    {
+        if (strcmp(current->subscription.event_name, event->name) == 0)
+        {
+            // Call subscriber callback
+            if (current->subscription.callback)
+            {
+                uflake_event_trace_record(EVENT_TRACE_CB_START, event->name, 0, 0,
+                                          current->subscription.subscription_id,
+                                          current->subscription.subscriber_pid);
+                current->subscription.callback(event);
+                uflake_event_trace_record(EVENT_TRACE_CB_END, event->name, 0, 0,
+                                          current->subscription.subscription_id,
+                                          current->subscription.subscriber_pid);
+                callback_count++;
+            }
+        }
+        current = current->next;
+    }
+
+    uflake_kernel_trace_record(KERNEL_TRACE_EVENT_END, event->name, (uint32_t)event_payload_size(event));
+
+    xSemaphoreGive(event_mutex);
+    ESP_LOGD(TAG, "Event '%s' delivered to %d subscribers", event->name, (int)callback_count);
+
+    // Last callback has returned - drop the event's buffer reference
+    if (event->buffer)
+    {
+        uflake_buffer_destroy(event->buffer);
+    }
+}
+
+// Check whether a pending policy slot may be dispatched now
+static bool policy_is_due(const policy_node_t *node, uint32_t now)
+{
+    switch (node->policy)
+    {
+    case EVENT_POLICY_DEBOUNCE:
+        return (now - node->last_publish_tick) >= node->param_ticks;
+    case EVENT_POLICY_MAX_RATE:
+        return (now - node->last_dispatch_tick) >= node->param_ticks;
+    case EVENT_POLICY_COALESCE:
+    default:
+        return true;
+    }
+}
+
+// Ticks until a pending policy slot may be dispatched
+static TickType_t policy_ticks_until_due(const policy_node_t *node, uint32_t now)
+{
+    uint32_t elapsed;
+
+    switch (node->policy)
+    {
+    case EVENT_POLICY_DEBOUNCE:
+        elapsed = now - node->last_publish_tick;
+        break;
+    case EVENT_POLICY_MAX_RATE:
+        elapsed = now - node->last_dispatch_tick;
+        break;
+    case EVENT_POLICY_COALESCE:
+    default:
+        return 0;
+    }
+
+    return (elapsed >= node->param_ticks) ? 0 : node->param_ticks - elapsed;
+}
+
+// Route an event raised from ISR context: policed names go to their slot,
+// everything else is dispatched straight away
+static void event_route_isr_event(const uflake_event_t *event)
+{
+    if (!event_store_policed(event))
+    {
+        event_dispatch(event);
+    }
+}
+
+static void event_drain_isr_ring(void)
 {
     uflake_event_t event;
 
-    // Process all pending events
-    while (xQueueReceive(event_queue, &event, 0) == pdTRUE)
+    while (true)
+    {
+        isr_event_slot_t *slot = &isr_event_ring[isr_dequeue_pos & ISR_EVENT_RING_MASK];
+        unsigned seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+        if (seq != isr_dequeue_pos + 1)
+            break; // Empty, or producer still filling this slot
+
+        event = slot->event;
+
+        // Release the slot for the next lap of producers
+        atomic_store_explicit(&slot->seq, isr_dequeue_pos + UFLAKE_ISR_EVENT_SLOTS, memory_order_release);
+        isr_dequeue_pos++;
+
+        event_route_isr_event(&event);
+    }
+
+    unsigned dropped = atomic_exchange_explicit(&isr_events_dropped, 0, memory_order_relaxed);
+    if (dropped > 0)
     {
-        ESP_LOGD(TAG, "Processing event: %s", event.name);
+        ESP_LOGW(TAG, "ISR event ring full - dropped %u events", dropped);
+    }
+}
+
+static void event_flush_policies(void)
+{
+    static uint32_t flush_pass = 0;
 
-        // Use timeout to prevent deadlock
-        if (xSemaphoreTake(event_mutex, pdMS_TO_TICKS(10)) != pdTRUE)
-            continue;
+    if (!policy_list)
+        return;
 
-        subscription_node_t *current = subscription_list;
-        uint32_t callback_count = 0;
+    uint32_t now = xTaskGetTickCount();
+    flush_pass++;
 
-        while (current)
+    // Restart from the head after every dispatch: the list may change while
+    // policy_mutex is released. flush_pass stops a callback that republishes
+    // the same event from being dispatched twice in one pass.
+    while (true)
+    {
+        uflake_event_t event;
+        bool due = false;
+
+        xSemaphoreTake(policy_mutex, portMAX_DELAY);
+        policy_node_t *node = policy_list;
+        while (node)
         {
-            if (strcmp(current->subscription.event_name, event.name) == 0)
+            if (node->pending && node->flush_pass != flush_pass && policy_is_due(node, now))
             {
-                // Call subscriber callback
-                if (current->subscription.callback)
-                {
-                    current->subscription.callback(&event);
-                    callback_count++;
-                }
+                event = node->latest;
+                node->pending = false;
+                node->last_dispatch_tick = now;
+                node->flush_pass = flush_pass;
+                due = true;
+                break;
             }
-            current = current->next;
+            node = node->next;
         }
+        xSemaphoreGive(policy_mutex);
 
-        xSemaphoreGive(event_mutex);
-        ESP_LOGD(TAG, "Event '%s' delivered to %d subscribers", event.name, (int)callback_count);
+        if (!due)
+            break;
+
+        // Dispatch outside policy_mutex so callbacks may publish again
+        event_dispatch(&event);
     }
 }
+
+uflake_result_t uflake_event_set_policy(const char *event_name, event_policy_t policy, uint32_t param_ms)
+{
+    if (!event_name || policy > EVENT_POLICY_MAX_RATE)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    if ((policy == EVENT_POLICY_DEBOUNCE || policy == EVENT_POLICY_MAX_RATE) && param_ms == 0)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    xSemaphoreTake(policy_mutex, portMAX_DELAY);
+
+    policy_node_t *prev = NULL;
+    policy_node_t *node = policy_list;
+    while (node && strncmp(node->event_name, event_name, sizeof(node->event_name) - 1) != 0)
+    {
+        prev = node;
+        node = node->next;
+    }
+
+    if (policy == EVENT_POLICY_NONE)
+    {
+        if (!node)
+        {
+            xSemaphoreGive(policy_mutex);
+            return UFLAKE_ERROR_NOT_FOUND;
+        }
+
+        if (prev)
+        {
+            prev->next = node->next;
+        }
+        else
+        {
+            policy_list = node->next;
+        }
+        xSemaphoreGive(policy_mutex);
+
+        // Hand a still-pending payload over to the normal queue
+        if (node->pending)
+        {
+            if (xQueueSend(event_queue, &node->latest, 0) == pdTRUE)
+            {
+                uflake_kernel_notify();
+            }
+            else if (node->latest.buffer)
+            {
+                uflake_buffer_destroy(node->latest.buffer);
+            }
+        }
+        uflake_free(node);
+        ESP_LOGI(TAG, "Cleared publish policy for '%s'", event_name);
+        return UFLAKE_OK;
+    }
+
+    if (!node)
+    {
+        node = (policy_node_t *)uflake_malloc(sizeof(policy_node_t), UFLAKE_MEM_INTERNAL);
+        if (!node)
+        {
+            xSemaphoreGive(policy_mutex);
+            return UFLAKE_ERROR_MEMORY;
+        }
+
+        memset(node, 0, sizeof(policy_node_t));
+        strncpy(node->event_name, event_name, sizeof(node->event_name) - 1);
+        node->event_name[sizeof(node->event_name) - 1] = '\0';
+        node->last_dispatch_tick = xTaskGetTickCount() - pdMS_TO_TICKS(param_ms);
+        node->next = policy_list;
+        policy_list = node;
+    }
+
+    node->policy = policy;
+    node->param_ticks = pdMS_TO_TICKS(param_ms);
+
+    xSemaphoreGive(policy_mutex);
+    ESP_LOGI(TAG, "Set publish policy %d (%d ms) for '%s'", policy, (int)param_ms, event_name);
+
+    return UFLAKE_OK;
+}
+
+void uflake_event_process(void)
+{
+    uflake_event_t event;
+
+    // Events raised from interrupts first - they are the most latency sensitive
+    event_drain_isr_ring();
+
+    // Process all pending events
+    while (xQueueReceive(event_queue, &event, 0) == pdTRUE)
+    {
+        event_dispatch(&event);
+    }
+
+    // Dispatch coalesced / debounced / rate-limited events that are due
+    event_flush_policies();
+}
+
+TickType_t uflake_event_next_wakeup(void)
+{
+    if (!event_queue)
+        return portMAX_DELAY;
+
+    if (uxQueueMessagesWaiting(event_queue) > 0)
+        return 0;
+
+    TickType_t wait = portMAX_DELAY;
+
+    xSemaphoreTake(policy_mutex, portMAX_DELAY);
+    uint32_t now = xTaskGetTickCount();
+    policy_node_t *node = policy_list;
+    while (node)
+    {
+        if (node->pending)
+        {
+            TickType_t remaining = policy_ticks_until_due(node, now);
+            if (remaining < wait)
+                wait = remaining;
+        }
+        node = node->next;
+    }
+    xSemaphoreGive(policy_mutex);
+
+    return wait;
+}
@@ -0,0 +1,277 @@
+#include "event_trace.h"
+#include "memory_manager.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "driver/uart.h"
+#include <stdatomic.h>
+#include <stdio.h>
+
+static const char *TAG = "EVENT_TRACE";
+
+// Export header - 20 bytes, little-endian
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint16_t name_count;
+    uint16_t reserved;
+    uint32_t record_count;
+    uint32_t lost_records;
+} event_trace_header_t;
+
+static uflake_event_trace_record_t *trace_ring = NULL;
+static uint32_t trace_capacity = 0;
+static atomic_uint trace_write_index = 0;
+static atomic_bool trace_active = false;
+static atomic_uint trace_recording = 0; // Recorders between the active check and their last store
+
+// Event name table - records carry a 16-bit index instead of the string
+static char trace_names[UFLAKE_EVENT_TRACE_MAX_NAMES][UFLAKE_MAX_EVENT_NAME];
+static atomic_uint trace_name_count = 0;
+static portMUX_TYPE trace_names_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint16_t IRAM_ATTR trace_name_id(const char *event_name)
+{
+    unsigned count = atomic_load_explicit(&trace_name_count, memory_order_acquire);
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (strncmp(trace_names[i], event_name, UFLAKE_MAX_EVENT_NAME - 1) == 0)
+        {
+            return (uint16_t)i;
+        }
+    }
+
+    // Not seen yet - insert (rescan under the lock, another core may have won)
+    uint16_t id = UINT16_MAX;
+    portENTER_CRITICAL_SAFE(&trace_names_lock);
+    count = atomic_load_explicit(&trace_name_count, memory_order_relaxed);
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (strncmp(trace_names[i], event_name, UFLAKE_MAX_EVENT_NAME - 1) == 0)
+        {
+            id = (uint16_t)i;
+            break;
+        }
+    }
+    if (id == UINT16_MAX && count < UFLAKE_EVENT_TRACE_MAX_NAMES)
+    {
+        strncpy(trace_names[count], event_name, UFLAKE_MAX_EVENT_NAME - 1);
+        trace_names[count][UFLAKE_MAX_EVENT_NAME - 1] = '\0';
+        atomic_store_explicit(&trace_name_count, count + 1, memory_order_release);
+        id = (uint16_t)count;
+    }
+    portEXIT_CRITICAL_SAFE(&trace_names_lock);
+
+    return id;
+}
+
+void IRAM_ATTR uflake_event_trace_record(event_trace_kind_t kind, const char *event_name, uint8_t flags,
+                                         size_t data_size, uint32_t subscription_id, uint32_t subscriber_pid)
+{
+    // Announce first, then check - trace_quiesce() sees either the count or the cleared flag
+    atomic_fetch_add(&trace_recording, 1);
+    if (!trace_active)
+    {
+        atomic_fetch_sub(&trace_recording, 1);
+        return;
+    }
+
+    // Wait-free slot reservation - safe from tasks on both cores and ISRs
+    unsigned index = atomic_fetch_add_explicit(&trace_write_index, 1, memory_order_relaxed);
+    uflake_event_trace_record_t *record = &trace_ring[index % trace_capacity];
+
+    record->timestamp_us = (uint32_t)esp_timer_get_time();
+    record->subscription_id = subscription_id;
+    record->name_id = trace_name_id(event_name);
+    record->kind = (uint8_t)kind;
+    record->flags = flags;
+    record->data_size = (data_size > UINT16_MAX) ? UINT16_MAX : (uint16_t)data_size;
+    record->subscriber_pid = (uint16_t)subscriber_pid;
+
+    atomic_fetch_sub_explicit(&trace_recording, 1, memory_order_release);
+}
+
+// Wait for recorders that passed the active check before it was cleared -
+// after this the ring can be read, cleared or freed
+static void trace_quiesce(void)
+{
+    while (atomic_load_explicit(&trace_recording, memory_order_acquire) != 0)
+    {
+        vTaskDelay(1); // A preempted recorder on this core needs the CPU to finish
+    }
+}
+
+uflake_result_t uflake_event_trace_start(uint32_t max_records)
+{
+    if (trace_active)
+        return UFLAKE_ERROR;
+
+    if (max_records == 0)
+        max_records = UFLAKE_EVENT_TRACE_DEFAULT_RECORDS;
+
+    // A recorder from the previous run may still be writing to the old ring
+    trace_quiesce();
+
+    if (trace_ring && trace_capacity != max_records)
+    {
+        uflake_free(trace_ring);
+        trace_ring = NULL;
+    }
+
+    if (!trace_ring)
+    {
+        size_t bytes = sizeof(uflake_event_trace_record_t) * max_records;
+        uflake_mem_type_t mem_type = uflake_memory_is_psram_available() ? UFLAKE_MEM_SPIRAM : UFLAKE_MEM_INTERNAL;
+
+        trace_ring = (uflake_event_trace_record_t *)uflake_malloc(bytes, mem_type);
+        if (!trace_ring)
+        {
+            ESP_LOGE(TAG, "Failed to allocate trace ring (%u records)", (unsigned)max_records);
+            return UFLAKE_ERROR_MEMORY;
+        }
+        trace_capacity = max_records;
+    }
+
+    uflake_event_trace_clear();
+    trace_active = true;
+
+    ESP_LOGI(TAG, "Event trace started (%u records)", (unsigned)trace_capacity);
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_event_trace_stop(void)
+{
+    if (!trace_active)
+        return UFLAKE_ERROR;
+
+    trace_active = false;
+    trace_quiesce();
+    ESP_LOGI(TAG, "Event trace stopped (%u records written)",
+             (unsigned)atomic_load(&trace_write_index));
+    return UFLAKE_OK;
+}
+
+void uflake_event_trace_clear(void)
+{
+    atomic_store(&trace_write_index, 0);
+
+    portENTER_CRITICAL(&trace_names_lock);
+    atomic_store(&trace_name_count, 0);
+    portEXIT_CRITICAL(&trace_names_lock);
+}
+
+bool uflake_event_trace_is_active(void)
+{
+    return trace_active;
+}
+
+uflake_result_t uflake_event_trace_export(event_trace_writer_t writer, void *ctx)
+{
+    if (!writer)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    if (!trace_ring)
+        return UFLAKE_ERROR_NOT_FOUND;
+
+    // Pause recording so the ring is stable while it is written out
+    bool was_active = trace_active;
+    trace_active = false;
+    trace_quiesce();
+
+    uint32_t written = atomic_load(&trace_write_index);
+    uint32_t record_count = (written > trace_capacity) ? trace_capacity : written;
+    uint32_t first = (written > trace_capacity) ? (written % trace_capacity) : 0;
+    uint16_t name_count = (uint16_t)atomic_load(&trace_name_count);
+
+    event_trace_header_t header = {
+        .magic = UFLAKE_EVENT_TRACE_MAGIC,
+        .version = UFLAKE_EVENT_TRACE_VERSION,
+        .record_size = sizeof(uflake_event_trace_record_t),
+        .name_count = name_count,
+        .reserved = 0,
+        .record_count = record_count,
+        .lost_records = written - record_count};
+
+    uflake_result_t result = UFLAKE_OK;
+
+    if (writer(&header, sizeof(header), ctx) != sizeof(header))
+    {
+        result = UFLAKE_ERROR;
+        goto done;
+    }
+
+    for (uint16_t i = 0; i < name_count; i++)
+    {
+        uint8_t len = (uint8_t)strnlen(trace_names[i], UFLAKE_MAX_EVENT_NAME);
+        if (writer(&len, 1, ctx) != 1 || writer(trace_names[i], len, ctx) != len)
+        {
+            result = UFLAKE_ERROR;
+            goto done;
+        }
+    }
+
+    // Oldest first: [first, capacity) then [0, first)
+    uint32_t tail_count = record_count - first;
+    size_t tail_bytes = tail_count * sizeof(uflake_event_trace_record_t);
+    size_t head_bytes = first * sizeof(uflake_event_trace_record_t);
+
+    if (writer(&trace_ring[first], tail_bytes, ctx) != tail_bytes ||
+        (head_bytes > 0 && writer(&trace_ring[0], head_bytes, ctx) != head_bytes))
+    {
+        result = UFLAKE_ERROR;
+    }
+
+done:
+    trace_active = was_active;
+
+    if (result == UFLAKE_OK)
+    {
+        ESP_LOGI(TAG, "Exported %u records, %u names (%u lost)",
+                 (unsigned)record_count, (unsigned)name_count, (unsigned)header.lost_records);
+    }
+    else
+    {
+        ESP_LOGE(TAG, "Trace export failed");
+    }
+    return result;
+}
+
+static size_t file_writer(const void *data, size_t size, void *ctx)
+{
+    return fwrite(data, 1, size, (FILE *)ctx);
+}
+
+uflake_result_t uflake_event_trace_export_file(const char *path)
+{
+    if (!path)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        return UFLAKE_ERROR_NOT_FOUND;
+    }
+
+    uflake_result_t result = uflake_event_trace_export(file_writer, file);
+    fclose(file);
+    return result;
+}
+
+static size_t uart_writer(const void *data, size_t size, void *ctx)
+{
+    int written = uart_write_bytes((uart_port_t)(intptr_t)ctx, data, size);
+    return (written < 0) ? 0 : (size_t)written;
+}
+
+uflake_result_t uflake_event_trace_export_uart(int uart_port)
+{
+    if (uart_port < 0 || uart_port >= UART_NUM_MAX)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    uflake_result_t result = uflake_event_trace_export(uart_writer, (void *)(intptr_t)uart_port);
+    uart_wait_tx_done((uart_port_t)uart_port, pdMS_TO_TICKS(1000));
+    return result;
+}
@@ -0,0 +1,300 @@
+#include "job_system.h"
+#include "esp_log.h"
+#include <stdio.h>
+
+static const char *TAG = "JOB_SYS";
+
+// Per-core deque: the owning worker pushes and pops at the bottom (newest
+// first, cache-warm), idle workers on the other core steal from the top
+// (oldest first, usually the biggest remaining work). Jobs are small, so a
+// spinlock per deque costs less than the job itself.
+typedef struct
+{
+    uflake_job_fn_t fn;
+    void *arg;
+    uflake_job_counter_t *counter;
+} job_t;
+
+typedef struct
+{
+    job_t slots[UFLAKE_JOB_DEQUE_SIZE];
+    uint32_t top;
+    uint32_t bottom;
+    portMUX_TYPE lock;
+} job_deque_t;
+
+typedef struct
+{
+    uflake_parallel_fn_t fn;
+    void *ctx;
+    uint32_t begin;
+    uint32_t end;
+} parallel_chunk_t;
+
+static job_deque_t job_deques[portNUM_PROCESSORS];
+static TaskHandle_t job_workers[portNUM_PROCESSORS] = {0};
+static volatile bool job_ready = false;
+static uflake_job_stats_t job_stats = {0};
+
+#define JOB_STAT_INC(field) __atomic_fetch_add(&job_stats.field, 1, __ATOMIC_RELAXED)
+
+static bool deque_push(job_deque_t *deque, const job_t *job)
+{
+    bool pushed = false;
+
+    portENTER_CRITICAL(&deque->lock);
+    if (deque->bottom - deque->top < UFLAKE_JOB_DEQUE_SIZE)
+    {
+        deque->slots[deque->bottom % UFLAKE_JOB_DEQUE_SIZE] = *job;
+        deque->bottom++;
+        pushed = true;
+    }
+    portEXIT_CRITICAL(&deque->lock);
+
+    return pushed;
+}
+
+static bool deque_pop(job_deque_t *deque, job_t *job)
+{
+    bool popped = false;
+
+    portENTER_CRITICAL(&deque->lock);
+    if (deque->bottom != deque->top)
+    {
+        deque->bottom--;
+        *job = deque->slots[deque->bottom % UFLAKE_JOB_DEQUE_SIZE];
+        popped = true;
+    }
+    portEXIT_CRITICAL(&deque->lock);
+
+    return popped;
+}
+
+static bool deque_steal(job_deque_t *deque, job_t *job)
+{
+    bool stolen = false;
+
+    portENTER_CRITICAL(&deque->lock);
+    if (deque->bottom != deque->top)
+    {
+        *job = deque->slots[deque->top % UFLAKE_JOB_DEQUE_SIZE];
+        deque->top++;
+        stolen = true;
+    }
+    portEXIT_CRITICAL(&deque->lock);
+
+    return stolen;
+}
+
+// Own deque first, then steal from the other cores
+static bool job_find(int core, job_t *job)
+{
+    if (deque_pop(&job_deques[core], job))
+        return true;
+
+    for (int i = 1; i < portNUM_PROCESSORS; i++)
+    {
+        if (deque_steal(&job_deques[(core + i) % portNUM_PROCESSORS], job))
+        {
+            JOB_STAT_INC(jobs_stolen);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void job_run(const job_t *job)
+{
+    job->fn(job->arg);
+
+    // Only the decrement that reaches zero gives, and only after the waiter
+    // dropped its reference - uflake_job_wait() consumes exactly that give
+    if (job->counter && __atomic_sub_fetch(&job->counter->pending, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        xSemaphoreGive(job->counter->done);
+    }
+}
+
+static void job_wake_workers(void)
+{
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        if (job_workers[core])
+            xTaskNotifyGive(job_workers[core]);
+    }
+}
+
+// Queue without waking the workers; runs the job inline if the deque is full
+static void job_enqueue(uflake_job_counter_t *counter, uflake_job_fn_t fn, void *arg)
+{
+    job_t job = {.fn = fn, .arg = arg, .counter = counter};
+
+    if (counter)
+        __atomic_fetch_add(&counter->pending, 1, __ATOMIC_ACQ_REL);
+
+    if (!job_ready || !deque_push(&job_deques[xPortGetCoreID()], &job))
+    {
+        JOB_STAT_INC(jobs_inline);
+        job_run(&job);
+    }
+}
+
+static void job_worker_fn(void *args)
+{
+    int core = (int)(intptr_t)args;
+    job_t job;
+
+    ESP_LOGI(TAG, "Job worker running on core %d", core);
+
+    while (true)
+    {
+        while (job_find(core, &job))
+        {
+            job_run(&job);
+            JOB_STAT_INC(jobs_run[core]);
+        }
+
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+uflake_result_t uflake_job_init(void)
+{
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        job_deques[core].top = 0;
+        job_deques[core].bottom = 0;
+        portMUX_INITIALIZE(&job_deques[core].lock);
+    }
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        char name[configMAX_TASK_NAME_LEN];
+        snprintf(name, sizeof(name), "uFlake_Job%d", core);
+
+        if (xTaskCreatePinnedToCore(job_worker_fn, name, UFLAKE_JOB_WORKER_STACK_SIZE,
+                                    (void *)(intptr_t)core, UFLAKE_JOB_WORKER_PRIORITY,
+                                    &job_workers[core], core) != pdPASS)
+        {
+            ESP_LOGE(TAG, "Failed to create job worker for core %d", core);
+            return UFLAKE_ERROR_MEMORY;
+        }
+    }
+
+    job_ready = true;
+    ESP_LOGI(TAG, "Job system initialized (%d workers)", portNUM_PROCESSORS);
+    return UFLAKE_OK;
+}
+
+void uflake_job_counter_init(uflake_job_counter_t *counter)
+{
+    if (!counter)
+        return;
+
+    counter->pending = 1; // The waiter's reference, dropped by uflake_job_wait()
+    counter->done = xSemaphoreCreateBinaryStatic(&counter->done_buffer);
+}
+
+uflake_result_t uflake_job_submit(uflake_job_counter_t *counter, uflake_job_fn_t fn, void *arg)
+{
+    if (!fn)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    if (uflake_kernel_is_in_isr())
+        return UFLAKE_ERROR;
+
+    job_enqueue(counter, fn, arg);
+    job_wake_workers();
+    return UFLAKE_OK;
+}
+
+void uflake_job_wait(uflake_job_counter_t *counter)
+{
+    if (!counter)
+        return;
+
+    // All jobs already finished - nobody will give
+    if (__atomic_sub_fetch(&counter->pending, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        counter->pending = 1;
+        return;
+    }
+
+    // Help with queued work instead of blocking while the batch is running
+    job_t job;
+    while (__atomic_load_n(&counter->pending, __ATOMIC_ACQUIRE) != 0 &&
+           job_ready && job_find(xPortGetCoreID(), &job))
+    {
+        job_run(&job);
+        JOB_STAT_INC(jobs_helped);
+    }
+
+    // Consume the give of whichever job finished last (possibly ours), so no
+    // worker touches the counter after we return
+    xSemaphoreTake(counter->done, portMAX_DELAY);
+    counter->pending = 1;
+}
+
+static void parallel_chunk_job(void *arg)
+{
+    parallel_chunk_t *chunk = (parallel_chunk_t *)arg;
+    chunk->fn(chunk->begin, chunk->end, chunk->ctx);
+}
+
+uflake_result_t uflake_job_parallel_for(uint32_t begin, uint32_t end, uint32_t grain,
+                                        uflake_parallel_fn_t fn, void *ctx)
+{
+    if (!fn)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    if (end <= begin)
+        return UFLAKE_OK;
+
+    uint32_t count = end - begin;
+    uint32_t chunks = count / (grain ? grain : 1);
+    if (chunks > UFLAKE_JOB_MAX_CHUNKS)
+        chunks = UFLAKE_JOB_MAX_CHUNKS;
+
+    if (chunks < 2 || !job_ready || uflake_kernel_is_in_isr())
+    {
+        fn(begin, end, ctx);
+        return UFLAKE_OK;
+    }
+
+    parallel_chunk_t chunk_args[UFLAKE_JOB_MAX_CHUNKS];
+    uflake_job_counter_t counter;
+    uflake_job_counter_init(&counter);
+
+    // Spread the remainder over the first chunks
+    uint32_t step = count / chunks;
+    uint32_t extra = count % chunks;
+    uint32_t start = begin;
+    for (uint32_t i = 0; i < chunks; i++)
+    {
+        uint32_t size = step + (i < extra ? 1 : 0);
+        chunk_args[i] = (parallel_chunk_t){.fn = fn, .ctx = ctx, .begin = start, .end = start + size};
+        start += size;
+    }
+
+    // Queue all but the first chunk, wake the workers once, run the first here
+    for (uint32_t i = 1; i < chunks; i++)
+    {
+        job_enqueue(&counter, parallel_chunk_job, &chunk_args[i]);
+    }
+    job_wake_workers();
+
+    fn(chunk_args[0].begin, chunk_args[0].end, ctx);
+    uflake_job_wait(&counter);
+
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_job_get_stats(uflake_job_stats_t *stats)
+{
+    if (!stats)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    *stats = job_stats;
+    return UFLAKE_OK;
+}
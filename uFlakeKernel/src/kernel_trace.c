@@ -0,0 +1,422 @@
+#include "kernel_trace.h"
+#include "memory_manager.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include "esp_freertos_hooks.h"
+#include "driver/uart.h"
+#include <stdio.h>
+
+static const char *TAG = "KERNEL_TRACE";
+
+// Export header - 16 bytes, little-endian, followed by one
+// kernel_trace_core_header_t per core
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint16_t core_count;
+    uint16_t label_count;
+    uint16_t task_count;
+    uint16_t cpu_mhz;
+} kernel_trace_header_t;
+
+typedef struct __attribute__((packed))
+{
+    uint32_t record_count;
+    uint32_t lost_records;
+} kernel_trace_core_header_t;
+
+// One ring per core. Only its own core writes it, with interrupts masked,
+// so reserving a slot needs no atomics and records never interleave.
+typedef struct
+{
+    uflake_kernel_trace_record_t *records;
+    uint32_t write_index;
+    uint32_t sync_ticks;
+} kernel_trace_ring_t;
+
+static kernel_trace_ring_t trace_rings[portNUM_PROCESSORS];
+static uint32_t trace_capacity = 0;
+static volatile bool trace_active = false;
+static volatile uint32_t trace_recording = 0; // Recorders between the active check and their last store
+
+// Label table - records carry a 16-bit index instead of the string. Most
+// labels are stable object names, so the pointer is checked first.
+static const char *trace_label_ptrs[UFLAKE_KERNEL_TRACE_MAX_LABELS];
+static char trace_labels[UFLAKE_KERNEL_TRACE_MAX_LABELS][UFLAKE_KERNEL_TRACE_LABEL_LEN];
+static volatile uint32_t trace_label_count = 0;
+static portMUX_TYPE trace_labels_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint16_t IRAM_ATTR trace_label_id(const char *label)
+{
+    if (!label)
+        return UFLAKE_KERNEL_TRACE_NO_LABEL;
+
+    uint32_t count = __atomic_load_n(&trace_label_count, __ATOMIC_ACQUIRE);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (trace_label_ptrs[i] == label &&
+            strncmp(trace_labels[i], label, UFLAKE_KERNEL_TRACE_LABEL_LEN - 1) == 0)
+        {
+            return (uint16_t)i;
+        }
+    }
+
+    // Not cached by pointer - match by name, insert if new
+    uint16_t id = UFLAKE_KERNEL_TRACE_NO_LABEL;
+    portENTER_CRITICAL_SAFE(&trace_labels_lock);
+    count = trace_label_count;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (strncmp(trace_labels[i], label, UFLAKE_KERNEL_TRACE_LABEL_LEN - 1) == 0)
+        {
+            id = (uint16_t)i;
+            break;
+        }
+    }
+    if (id == UFLAKE_KERNEL_TRACE_NO_LABEL && count < UFLAKE_KERNEL_TRACE_MAX_LABELS)
+    {
+        strncpy(trace_labels[count], label, UFLAKE_KERNEL_TRACE_LABEL_LEN - 1);
+        trace_labels[count][UFLAKE_KERNEL_TRACE_LABEL_LEN - 1] = '\0';
+        trace_label_ptrs[count] = label;
+        __atomic_store_n(&trace_label_count, count + 1, __ATOMIC_RELEASE);
+        id = (uint16_t)count;
+    }
+    portEXIT_CRITICAL_SAFE(&trace_labels_lock);
+
+    return id;
+}
+
+static void IRAM_ATTR trace_write(kernel_trace_kind_t kind, uint16_t label_id, uint32_t arg)
+{
+    uint8_t flags = uflake_kernel_is_in_isr() ? KERNEL_TRACE_FLAG_ISR : 0;
+
+    // Masking interrupts pins us to this core and keeps ISRs out of our slot
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    int core = esp_cpu_get_core_id();
+    kernel_trace_ring_t *ring = &trace_rings[core];
+    uflake_kernel_trace_record_t *record = &ring->records[ring->write_index % trace_capacity];
+    ring->write_index++;
+
+    record->ccount = esp_cpu_get_cycle_count();
+    record->kind = (uint8_t)kind;
+    record->flags = flags;
+    record->label_id = label_id;
+    record->task = (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandleForCore(core);
+    record->arg = arg;
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+}
+
+// Announce first, then check - trace_quiesce() sees either the count or the cleared flag
+static inline bool IRAM_ATTR trace_enter(void)
+{
+    __atomic_fetch_add(&trace_recording, 1, __ATOMIC_SEQ_CST);
+    if (!trace_active)
+    {
+        __atomic_fetch_sub(&trace_recording, 1, __ATOMIC_RELEASE);
+        return false;
+    }
+    return true;
+}
+
+static inline void IRAM_ATTR trace_leave(void)
+{
+    __atomic_fetch_sub(&trace_recording, 1, __ATOMIC_RELEASE);
+}
+
+// Wait for recorders that passed the active check before it was cleared -
+// after this the rings can be read, cleared or freed
+static void trace_quiesce(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&trace_recording, __ATOMIC_ACQUIRE) != 0)
+    {
+        vTaskDelay(1); // A preempted recorder on this core needs the CPU to finish
+    }
+}
+
+void IRAM_ATTR uflake_kernel_trace_record(kernel_trace_kind_t kind, const char *label, uint32_t arg)
+{
+    if (!trace_enter())
+        return;
+
+    trace_write(kind, trace_label_id(label), arg);
+    trace_leave();
+}
+
+void IRAM_ATTR uflake_kernel_trace_task_switched_in(void)
+{
+    if (!trace_enter())
+        return;
+
+    trace_write(KERNEL_TRACE_TASK_SWITCH, UFLAKE_KERNEL_TRACE_NO_LABEL, 0);
+    trace_leave();
+}
+
+// Cycle counters differ per core and wrap every few seconds - a periodic
+// (cycles, microseconds) pair per core lets the converter unwrap and align them
+static void IRAM_ATTR trace_tick_hook(void)
+{
+    if (!trace_enter())
+        return;
+
+    kernel_trace_ring_t *ring = &trace_rings[esp_cpu_get_core_id()];
+    if (++ring->sync_ticks >= UFLAKE_KERNEL_TRACE_SYNC_TICKS)
+    {
+        ring->sync_ticks = 0;
+        trace_write(KERNEL_TRACE_SYNC, UFLAKE_KERNEL_TRACE_NO_LABEL, (uint32_t)esp_timer_get_time());
+    }
+    trace_leave();
+}
+
+uflake_result_t uflake_kernel_trace_start(uint32_t records_per_core)
+{
+    if (trace_active)
+        return UFLAKE_ERROR;
+
+    if (records_per_core == 0)
+        records_per_core = UFLAKE_KERNEL_TRACE_DEFAULT_RECORDS;
+
+    // A recorder from before the last stop or export may still be writing
+    trace_quiesce();
+
+    if (trace_capacity != records_per_core)
+    {
+        for (int core = 0; core < portNUM_PROCESSORS; core++)
+        {
+            uflake_free(trace_rings[core].records);
+            trace_rings[core].records = NULL;
+        }
+        trace_capacity = 0;
+
+        size_t bytes = sizeof(uflake_kernel_trace_record_t) * records_per_core;
+        for (int core = 0; core < portNUM_PROCESSORS; core++)
+        {
+            trace_rings[core].records = (uflake_kernel_trace_record_t *)uflake_malloc(bytes, UFLAKE_MEM_INTERNAL);
+            if (!trace_rings[core].records)
+            {
+                ESP_LOGE(TAG, "Failed to allocate trace ring (%u records)", (unsigned)records_per_core);
+                return UFLAKE_ERROR_MEMORY;
+            }
+        }
+        trace_capacity = records_per_core;
+    }
+
+    uflake_kernel_trace_clear();
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        esp_register_freertos_tick_hook_for_cpu(trace_tick_hook, core);
+    }
+
+    trace_active = true;
+
+    // First clock pair right away, the tick hook keeps them coming
+    trace_write(KERNEL_TRACE_SYNC, UFLAKE_KERNEL_TRACE_NO_LABEL, (uint32_t)esp_timer_get_time());
+
+    ESP_LOGI(TAG, "Kernel trace started (%u records per core)", (unsigned)trace_capacity);
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_kernel_trace_stop(void)
+{
+    if (!trace_active)
+        return UFLAKE_ERROR;
+
+    trace_active = false;
+    trace_quiesce();
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        esp_deregister_freertos_tick_hook_for_cpu(trace_tick_hook, core);
+    }
+
+    ESP_LOGI(TAG, "Kernel trace stopped");
+    return UFLAKE_OK;
+}
+
+void uflake_kernel_trace_clear(void)
+{
+    // Pause recording so no recorder writes into a ring being reset
+    bool was_active = trace_active;
+    trace_active = false;
+    trace_quiesce();
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        trace_rings[core].write_index = 0;
+        trace_rings[core].sync_ticks = 0;
+    }
+
+    portENTER_CRITICAL(&trace_labels_lock);
+    trace_label_count = 0;
+    portEXIT_CRITICAL(&trace_labels_lock);
+
+    trace_active = was_active;
+}
+
+bool uflake_kernel_trace_is_active(void)
+{
+    return trace_active;
+}
+
+static bool trace_write_name(kernel_trace_writer_t writer, void *ctx, const char *name, size_t max_len)
+{
+    uint8_t len = (uint8_t)strnlen(name, max_len);
+    return writer(&len, 1, ctx) == 1 && writer(name, len, ctx) == len;
+}
+
+uflake_result_t uflake_kernel_trace_export(kernel_trace_writer_t writer, void *ctx)
+{
+    if (!writer)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    if (!trace_capacity)
+        return UFLAKE_ERROR_NOT_FOUND;
+
+    // Pause recording so the rings are stable while they are written out
+    bool was_active = trace_active;
+    trace_active = false;
+    trace_quiesce();
+
+    uflake_result_t result = UFLAKE_OK;
+    uint16_t label_count = (uint16_t)trace_label_count;
+
+    // Names of the tasks alive now; tasks that exited during the trace show by handle
+    TaskStatus_t *tasks = NULL;
+    UBaseType_t task_count = 0;
+#if configUSE_TRACE_FACILITY == 1
+    UBaseType_t task_slots = uxTaskGetNumberOfTasks() + 4;
+    tasks = (TaskStatus_t *)uflake_malloc(task_slots * sizeof(TaskStatus_t), UFLAKE_MEM_INTERNAL);
+    if (tasks)
+    {
+        task_count = uxTaskGetSystemState(tasks, task_slots, NULL);
+    }
+#endif
+
+    kernel_trace_header_t header = {
+        .magic = UFLAKE_KERNEL_TRACE_MAGIC,
+        .version = UFLAKE_KERNEL_TRACE_VERSION,
+        .record_size = sizeof(uflake_kernel_trace_record_t),
+        .core_count = portNUM_PROCESSORS,
+        .label_count = label_count,
+        .task_count = (uint16_t)task_count,
+        .cpu_mhz = (uint16_t)esp_rom_get_cpu_ticks_per_us()};
+
+    if (writer(&header, sizeof(header), ctx) != sizeof(header))
+    {
+        result = UFLAKE_ERROR;
+        goto done;
+    }
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        uint32_t written = trace_rings[core].write_index;
+        kernel_trace_core_header_t core_header = {
+            .record_count = (written > trace_capacity) ? trace_capacity : written,
+            .lost_records = (written > trace_capacity) ? written - trace_capacity : 0};
+
+        if (writer(&core_header, sizeof(core_header), ctx) != sizeof(core_header))
+        {
+            result = UFLAKE_ERROR;
+            goto done;
+        }
+    }
+
+    for (uint16_t i = 0; i < label_count; i++)
+    {
+        if (!trace_write_name(writer, ctx, trace_labels[i], UFLAKE_KERNEL_TRACE_LABEL_LEN))
+        {
+            result = UFLAKE_ERROR;
+            goto done;
+        }
+    }
+
+    for (UBaseType_t i = 0; i < task_count; i++)
+    {
+        uint32_t handle = (uint32_t)(uintptr_t)tasks[i].xHandle;
+        if (writer(&handle, sizeof(handle), ctx) != sizeof(handle) ||
+            !trace_write_name(writer, ctx, tasks[i].pcTaskName, configMAX_TASK_NAME_LEN))
+        {
+            result = UFLAKE_ERROR;
+            goto done;
+        }
+    }
+
+    // Per core, oldest first: [first, capacity) then [0, first)
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        uint32_t written = trace_rings[core].write_index;
+        uint32_t record_count = (written > trace_capacity) ? trace_capacity : written;
+        uint32_t first = (written > trace_capacity) ? (written % trace_capacity) : 0;
+        size_t tail_bytes = (record_count - first) * sizeof(uflake_kernel_trace_record_t);
+        size_t head_bytes = first * sizeof(uflake_kernel_trace_record_t);
+        uflake_kernel_trace_record_t *records = trace_rings[core].records;
+
+        if (writer(&records[first], tail_bytes, ctx) != tail_bytes ||
+            (head_bytes > 0 && writer(&records[0], head_bytes, ctx) != head_bytes))
+        {
+            result = UFLAKE_ERROR;
+            goto done;
+        }
+    }
+
+done:
+    uflake_free(tasks);
+    trace_active = was_active;
+
+    if (result == UFLAKE_OK)
+    {
+        ESP_LOGI(TAG, "Exported %u cores, %u labels, %u tasks", (unsigned)portNUM_PROCESSORS,
+                 (unsigned)label_count, (unsigned)task_count);
+    }
+    else
+    {
+        ESP_LOGE(TAG, "Trace export failed");
+    }
+    return result;
+}
+
+static size_t file_writer(const void *data, size_t size, void *ctx)
+{
+    return fwrite(data, 1, size, (FILE *)ctx);
+}
+
+uflake_result_t uflake_kernel_trace_export_file(const char *path)
+{
+    if (!path)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        return UFLAKE_ERROR_NOT_FOUND;
+    }
+
+    uflake_result_t result = uflake_kernel_trace_export(file_writer, file);
+    fclose(file);
+    return result;
+}
+
+static size_t uart_writer(const void *data, size_t size, void *ctx)
+{
+    int written = uart_write_bytes((uart_port_t)(intptr_t)ctx, data, size);
+    return (written < 0) ? 0 : (size_t)written;
+}
+
+uflake_result_t uflake_kernel_trace_export_uart(int uart_port)
+{
+    if (uart_port < 0 || uart_port >= UART_NUM_MAX)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    uflake_result_t result = uflake_kernel_trace_export(uart_writer, (void *)(intptr_t)uart_port);
+    uart_wait_tx_done((uart_port_t)uart_port, pdMS_TO_TICKS(1000));
+    return result;
+}
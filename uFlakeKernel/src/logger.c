@@ -1,15 +1,615 @@
 #include "logger.h"
 #include "memory_manager.h"
 #include "esp_log.h"
+#include "driver/uart.h"
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 
 static const char *TAG = "LOGGER";
+
+// Binary record - the format is kept by pointer and the arguments raw, in
+// the order and size the format consumes them. Formatting walks the format
+// again and feeds each conversion its stored argument.
+typedef struct
+{
+    int64_t timestamp_us;
+    const char *format; // NULL = empty slot
+    uint32_t seq;       // Reservation number + 1 once committed, 0 while being written
+    uint8_t level;
+    uint8_t tag_id;
+    uint8_t arg_size; // Bytes used in args
+    uint8_t flags;    // LOG_RECORD_*
+    uint8_t args[UFLAKE_LOG_ARG_BYTES];
+} log_record_t;
+
+#define LOG_RECORD_TRUNCATED 0x01 // Arguments did not fit; the text stops where they ran out
+
+#define LOG_TAG_NONE 0xFF
+#define LOG_MESSAGE_LEN sizeof(((log_entry_t *)0)->message)
+
+// Argument classes of a printf conversion
+typedef enum
+{
+    LOG_ARG_NONE,   // %%
+    LOG_ARG_INT,    // int-promoted: d i u x X o c with no or hh/h length
+    LOG_ARG_LONG,   // l
+    LOG_ARG_LLONG,  // ll, j
+    LOG_ARG_SIZE,   // z, t
+    LOG_ARG_PTR,    // p
+    LOG_ARG_DOUBLE, // f e g a (float is promoted)
+    LOG_ARG_STRING, // s - copied into the record
+    LOG_ARG_UNSUPPORTED
+} log_arg_class_t;
+
+typedef struct
+{
+    size_t length;      // Characters from '%' up to and including the conversion
+    uint8_t star_count; // '*' width / precision, each an int argument before the value
+    log_arg_class_t arg;
+} log_spec_t;
+
+// One ring per core. Writers never lock: a slot is reserved by an atomic
+// increment of head, filled, then committed by publishing its sequence
+// number, so tasks on both cores and ISRs can log at the same time. A
+// writer lapped mid-write (a full ring of newer records while it was
+// preempted) can garble that one record, never the reader.
+typedef struct
+{
+    log_record_t *records;
+    uint32_t head; // Next reservation number (atomic)
+} log_ring_t;
+
+_Static_assert((UFLAKE_LOG_RING_SIZE & (UFLAKE_LOG_RING_SIZE - 1)) == 0, "UFLAKE_LOG_RING_SIZE must be a power of two");
+_Static_assert(UFLAKE_LOG_ARG_BYTES <= UINT8_MAX, "UFLAKE_LOG_ARG_BYTES must fit log_record_t.arg_size");
+
 static log_level_t current_log_level = LOG_LEVEL_INFO;
+static log_ring_t log_rings[portNUM_PROCESSORS];
+static bool log_ready = false;
+
+// Readers only - serialises the console drain position
 static SemaphoreHandle_t log_mutex = NULL;
-static log_entry_t *log_buffer = NULL;
-static size_t log_buffer_size = 100;
-static size_t log_buffer_index = 0;
+static uint32_t log_drain_pos[portNUM_PROCESSORS];
+static uint32_t log_dropped = 0;
+static TaskHandle_t log_task = NULL;
+static volatile bool log_drain_pending = false;
+
+// Background stream (uflake_log_stream_start)
+#define LOG_STREAM_LINE_LEN (LOG_MESSAGE_LEN + 48) // Level, timestamp, tag and message
+
+typedef struct
+{
+    TaskHandle_t task;
+    uflake_log_writer_t writer;
+    void *ctx;
+    FILE *file; // Closed on stop when the stream owns it
+    log_level_t max_level;
+    char tag[16]; // Empty = every tag
+    char *batch;  // UFLAKE_LOG_STREAM_BATCH lines
+    volatile bool stop;
+} log_stream_t;
+
+static log_stream_t log_stream = {0};
+
+// Interned tags (pointer cache first, then by name)
+static const char *log_tag_ptrs[UFLAKE_LOG_MAX_TAGS];
+static char log_tag_names[UFLAKE_LOG_MAX_TAGS][16];
+static uint32_t log_tag_count = 0;
+static portMUX_TYPE log_tag_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char log_level_letters[] = {'E', 'W', 'I', 'D', 'V'};
+
+static uint8_t log_tag_id(const char *tag)
+{
+    for (uint32_t i = 0; i < log_tag_count; i++)
+    {
+        if (log_tag_ptrs[i] == tag)
+            return (uint8_t)i;
+    }
+
+    uint8_t id = LOG_TAG_NONE;
+
+    portENTER_CRITICAL_SAFE(&log_tag_lock);
+    for (uint32_t i = 0; i < log_tag_count && id == LOG_TAG_NONE; i++)
+    {
+        if (strncmp(log_tag_names[i], tag, sizeof(log_tag_names[i]) - 1) == 0)
+            id = (uint8_t)i;
+    }
+    if (id == LOG_TAG_NONE && log_tag_count < UFLAKE_LOG_MAX_TAGS)
+    {
+        id = (uint8_t)log_tag_count;
+        strncpy(log_tag_names[id], tag, sizeof(log_tag_names[id]) - 1);
+        log_tag_ptrs[id] = tag;
+        log_tag_count++; // Published last - readers scan up to the count
+    }
+    portEXIT_CRITICAL_SAFE(&log_tag_lock);
+
+    return id;
+}
+
+static const char *log_tag_name(uint8_t tag_id)
+{
+    return (tag_id < log_tag_count) ? log_tag_names[tag_id] : "?";
+}
+
+// Parse the conversion starting at format[0] == '%'
+static void log_parse_spec(const char *format, log_spec_t *spec)
+{
+    const char *p = format + 1;
+    int longs = 0;
+    bool size_mod = false;
+
+    spec->star_count = 0;
+
+    while (*p && strchr("-+ #0'", *p))
+        p++;
+    if (*p == '*')
+    {
+        spec->star_count++;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9')
+        p++;
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*')
+        {
+            spec->star_count++;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9')
+            p++;
+    }
+
+    while (*p && strchr("hlLjzt", *p))
+    {
+        if (*p == 'l' || *p == 'j')
+            longs += (*p == 'j') ? 2 : 1;
+        else if (*p == 'z' || *p == 't')
+            size_mod = true;
+        else if (*p == 'L')
+            longs = 3;
+        p++;
+    }
+
+    switch (*p)
+    {
+    case '%':
+        spec->arg = LOG_ARG_NONE;
+        break;
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+    case 'c':
+        spec->arg = size_mod ? LOG_ARG_SIZE : (longs >= 2) ? LOG_ARG_LLONG : (longs == 1) ? LOG_ARG_LONG : LOG_ARG_INT;
+        break;
+    case 'p':
+        spec->arg = LOG_ARG_PTR;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec->arg = (longs == 3) ? LOG_ARG_UNSUPPORTED : LOG_ARG_DOUBLE;
+        break;
+    case 's':
+        spec->arg = LOG_ARG_STRING;
+        break;
+    default:
+        spec->arg = LOG_ARG_UNSUPPORTED; // %n, wide chars, or a broken format
+        break;
+    }
+
+    spec->length = (size_t)(p - format) + (*p ? 1 : 0);
+}
+
+static bool log_put(log_record_t *record, const void *value, size_t size)
+{
+    if (record->arg_size + size > UFLAKE_LOG_ARG_BYTES)
+        return false;
+
+    memcpy(&record->args[record->arg_size], value, size);
+    record->arg_size += size;
+    return true;
+}
+
+// Copy the raw arguments the format consumes - no formatting here
+static void log_capture_args(log_record_t *record, const char *format, va_list args)
+{
+    record->arg_size = 0;
+    record->flags = 0;
+
+    for (const char *p = format; *p; p++)
+    {
+        if (*p != '%')
+            continue;
+
+        log_spec_t spec;
+        log_parse_spec(p, &spec);
+        p += spec.length - 1;
+
+        bool stored = true;
+        for (uint8_t i = 0; i < spec.star_count && stored; i++)
+        {
+            int star = va_arg(args, int);
+            stored = log_put(record, &star, sizeof(star));
+        }
+
+        switch (spec.arg)
+        {
+        case LOG_ARG_NONE:
+            break;
+        case LOG_ARG_INT:
+        {
+            int value = va_arg(args, int);
+            stored = stored && log_put(record, &value, sizeof(value));
+            break;
+        }
+        case LOG_ARG_LONG:
+        {
+            long value = va_arg(args, long);
+            stored = stored && log_put(record, &value, sizeof(value));
+            break;
+        }
+        case LOG_ARG_LLONG:
+        {
+            long long value = va_arg(args, long long);
+            stored = stored && log_put(record, &value, sizeof(value));
+            break;
+        }
+        case LOG_ARG_SIZE:
+        {
+            size_t value = va_arg(args, size_t);
+            stored = stored && log_put(record, &value, sizeof(value));
+            break;
+        }
+        case LOG_ARG_PTR:
+        {
+            void *value = va_arg(args, void *);
+            stored = stored && log_put(record, &value, sizeof(value));
+            break;
+        }
+        case LOG_ARG_DOUBLE:
+        {
+            double value = va_arg(args, double);
+            stored = stored && log_put(record, &value, sizeof(value));
+            break;
+        }
+        case LOG_ARG_STRING:
+        {
+            // Strings may live on the caller's stack - copy what fits, always terminated
+            const char *value = va_arg(args, const char *);
+            if (!value)
+                value = "(null)";
+
+            size_t room = UFLAKE_LOG_ARG_BYTES - record->arg_size;
+            size_t len = strlen(value);
+            if (!stored || room == 0)
+            {
+                stored = false;
+                break;
+            }
+            if (len >= room)
+            {
+                len = room - 1;
+                record->flags |= LOG_RECORD_TRUNCATED;
+            }
+            memcpy(&record->args[record->arg_size], value, len);
+            record->args[record->arg_size + len] = '\0';
+            record->arg_size += len + 1;
+            break;
+        }
+        default:
+            stored = false;
+            break;
+        }
+
+        if (!stored)
+        {
+            record->flags |= LOG_RECORD_TRUNCATED;
+            return;
+        }
+    }
+}
+
+static bool log_get(const log_record_t *record, size_t *offset, void *value, size_t size)
+{
+    if (*offset + size > record->arg_size)
+        return false;
+
+    memcpy(value, &record->args[*offset], size);
+    *offset += size;
+    return true;
+}
+
+// Rebuild the text of a record; called only when a record is read or printed
+static void log_format_record(const log_record_t *record, char *out, size_t out_size)
+{
+    size_t pos = 0;
+    size_t offset = 0;
+
+    for (const char *p = record->format; *p && pos + 1 < out_size; p++)
+    {
+        if (*p != '%')
+        {
+            out[pos++] = *p;
+            continue;
+        }
+
+        log_spec_t spec;
+        log_parse_spec(p, &spec);
+
+        // Resolve '*' into digits so every conversion formats with a single argument
+        char conversion[24];
+        size_t conv_len = 0;
+        bool ok = (spec.arg != LOG_ARG_UNSUPPORTED);
+        for (size_t i = 0; i < spec.length && ok; i++)
+        {
+            if (p[i] == '*')
+            {
+                int star;
+                ok = log_get(record, &offset, &star, sizeof(star));
+                if (ok)
+                    conv_len += snprintf(&conversion[conv_len], sizeof(conversion) - conv_len, "%d", star);
+            }
+            else
+            {
+                conversion[conv_len++] = p[i];
+            }
+            ok = ok && conv_len < sizeof(conversion) - 1;
+        }
+        conversion[ok ? conv_len : 0] = '\0';
+
+        char *dest = &out[pos];
+        size_t room = out_size - pos;
+        int written = 0;
+
+        if (ok)
+        {
+            switch (spec.arg)
+            {
+            case LOG_ARG_NONE:
+                written = snprintf(dest, room, "%%");
+                break;
+            case LOG_ARG_INT:
+            {
+                int value;
+                if ((ok = log_get(record, &offset, &value, sizeof(value))))
+                    written = snprintf(dest, room, conversion, value);
+                break;
+            }
+            case LOG_ARG_LONG:
+            {
+                long value;
+                if ((ok = log_get(record, &offset, &value, sizeof(value))))
+                    written = snprintf(dest, room, conversion, value);
+                break;
+            }
+            case LOG_ARG_LLONG:
+            {
+                long long value;
+                if ((ok = log_get(record, &offset, &value, sizeof(value))))
+                    written = snprintf(dest, room, conversion, value);
+                break;
+            }
+            case LOG_ARG_SIZE:
+            {
+                size_t value;
+                if ((ok = log_get(record, &offset, &value, sizeof(value))))
+                    written = snprintf(dest, room, conversion, value);
+                break;
+            }
+            case LOG_ARG_PTR:
+            {
+                void *value;
+                if ((ok = log_get(record, &offset, &value, sizeof(value))))
+                    written = snprintf(dest, room, conversion, value);
+                break;
+            }
+            case LOG_ARG_DOUBLE:
+            {
+                double value;
+                if ((ok = log_get(record, &offset, &value, sizeof(value))))
+                    written = snprintf(dest, room, conversion, value);
+                break;
+            }
+            case LOG_ARG_STRING:
+            {
+                const char *value = (const char *)&record->args[offset];
+                size_t len = strnlen(value, record->arg_size - offset);
+                if ((ok = (offset < record->arg_size)))
+                {
+                    offset += len + 1;
+                    written = snprintf(dest, room, conversion, value);
+                }
+                break;
+            }
+            default:
+                ok = false;
+                break;
+            }
+        }
+
+        if (!ok)
+        {
+            // Arguments ran out (truncated record) - mark the cut and stop
+            snprintf(dest, room, "...");
+            pos += strnlen(dest, room);
+            break;
+        }
+
+        pos += (written < 0) ? 0 : ((size_t)written < room ? (size_t)written : room - 1);
+        p += spec.length - 1;
+    }
+
+    out[pos < out_size ? pos : out_size - 1] = '\0';
+}
+
+static void log_record_to_entry(const log_record_t *record, log_entry_t *entry)
+{
+    entry->timestamp = (uint32_t)(record->timestamp_us / (portTICK_PERIOD_MS * 1000));
+    entry->level = (log_level_t)record->level;
+    strncpy(entry->tag, log_tag_name(record->tag_id), sizeof(entry->tag) - 1);
+    entry->tag[sizeof(entry->tag) - 1] = '\0';
+
+    if (record->format)
+        log_format_record(record, entry->message, sizeof(entry->message));
+    else
+        entry->message[0] = '\0';
+}
+
+static void log_print_record(const log_record_t *record)
+{
+    char message[LOG_MESSAGE_LEN];
+    const char *tag = log_tag_name(record->tag_id);
+
+    log_format_record(record, message, sizeof(message));
+
+    // Same layout as ESP_LOGx, stamped with the capture time rather than the print time
+    esp_log_write((esp_log_level_t)(record->level + 1), tag, "%c (%lu) %s: %s\n",
+                  log_level_letters[record->level], (unsigned long)(record->timestamp_us / 1000), tag, message);
+}
+
+// Re-reads of an in-flight slot before the reader gives up on it. A writer
+// fills its slot in a few microseconds unless it is preempted; this covers
+// the first case without letting the second hold back the whole ring.
+#define LOG_COMMIT_SPINS 2000
+
+// Wait a bounded time for the slot reserved as pos to leave the in-flight
+// state; false if it is still being written
+static bool log_wait_commit(const log_record_t *record, uint32_t pos)
+{
+    for (int spin = 0; spin < LOG_COMMIT_SPINS; spin++)
+    {
+        uint32_t seq = __atomic_load_n(&record->seq, __ATOMIC_ACQUIRE);
+        if (seq != 0 && seq != pos + 1 - UFLAKE_LOG_RING_SIZE)
+            return true;
+    }
+    return false;
+}
+
+// Copy the record at *pos of one ring if it is committed. Skips (and
+// counts) records the writers overwrote, and records still in flight after
+// a bounded wait; returns false if the ring has nothing newer yet.
+static bool log_ring_peek(int core, uint32_t *pos, log_record_t *out, uint32_t *dropped)
+{
+    log_ring_t *ring = &log_rings[core];
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    while (*pos != head)
+    {
+        if (head - *pos > UFLAKE_LOG_RING_SIZE)
+        {
+            // Lapped - the oldest still in the ring is head - size
+            *dropped += head - *pos - UFLAKE_LOG_RING_SIZE;
+            *pos = head - UFLAKE_LOG_RING_SIZE;
+            continue;
+        }
+
+        log_record_t *record = &ring->records[*pos & (UFLAKE_LOG_RING_SIZE - 1)];
+        uint32_t seq = __atomic_load_n(&record->seq, __ATOMIC_ACQUIRE);
+
+        if (seq == *pos + 1)
+        {
+            *out = *record;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&record->seq, __ATOMIC_RELAXED) == seq)
+            {
+                // Only a lapped writer can garble a committed record; keep it printable
+                if (out->level > LOG_LEVEL_VERBOSE)
+                    out->level = LOG_LEVEL_VERBOSE;
+                return true;
+            }
+        }
+        else if (seq == 0 || seq == *pos + 1 - UFLAKE_LOG_RING_SIZE)
+        {
+            // Still being written - look again once it commits (or gets lapped)
+            if (log_wait_commit(record, *pos))
+            {
+                head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+                continue;
+            }
+        }
+
+        // Overwritten before or while we read it, or its writer is stalled
+        (*dropped)++;
+        (*pos)++;
+    }
+
+    return false;
+}
+
+// Next record across all cores, oldest timestamp first
+static bool log_read_next(uint32_t pos[portNUM_PROCESSORS], log_record_t *out, uint32_t *dropped)
+{
+    log_record_t candidates[portNUM_PROCESSORS];
+    int best = -1;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        if (log_ring_peek(core, &pos[core], &candidates[core], dropped) &&
+            (best < 0 || candidates[core].timestamp_us < candidates[best].timestamp_us))
+        {
+            best = core;
+        }
+    }
+
+    if (best < 0)
+        return false;
+
+    *out = candidates[best];
+    pos[best]++;
+    return true;
+}
+
+// Print records the console has not seen yet
+static void log_print_gap(uint32_t lost)
+{
+    log_dropped += lost;
+    esp_log_write(ESP_LOG_WARN, TAG, "-- %lu log records dropped --\n", (unsigned long)lost);
+}
+
+static void log_drain(void)
+{
+    log_record_t record;
+    uint32_t lost = 0;
+
+    xSemaphoreTake(log_mutex, portMAX_DELAY);
+    while (log_read_next(log_drain_pos, &record, &lost))
+    {
+        // Said before the record it precedes - the gap came first
+        if (lost)
+        {
+            log_print_gap(lost);
+            lost = 0;
+        }
+        log_print_record(&record);
+    }
+    if (lost)
+    {
+        log_print_gap(lost);
+    }
+    xSemaphoreGive(log_mutex);
+}
+
+static void log_task_fn(void *args)
+{
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        log_drain_pending = false;
+        log_drain();
+    }
+}
 
 uflake_result_t uflake_logger_init(void)
 {
@@ -20,16 +620,33 @@ uflake_result_t uflake_logger_init(void)
         return UFLAKE_ERROR_MEMORY;
     }
 
-    log_buffer = (log_entry_t *)uflake_malloc(sizeof(log_entry_t) * log_buffer_size, UFLAKE_MEM_INTERNAL);
-    if (!log_buffer)
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
     {
-        ESP_LOGE(TAG, "Failed to allocate log buffer");
-        return UFLAKE_ERROR_MEMORY;
+        size_t ring_bytes = sizeof(log_record_t) * UFLAKE_LOG_RING_SIZE;
+        log_rings[core].records = (log_record_t *)uflake_malloc(ring_bytes, UFLAKE_MEM_INTERNAL);
+        if (!log_rings[core].records)
+        {
+            ESP_LOGE(TAG, "Failed to allocate log buffer");
+            return UFLAKE_ERROR_MEMORY;
+        }
+
+        memset(log_rings[core].records, 0, ring_bytes);
+        log_rings[core].head = 0;
+        log_drain_pos[core] = 0;
     }
 
-    memset(log_buffer, 0, sizeof(log_entry_t) * log_buffer_size);
+#if UFLAKE_LOG_DEFERRED
+    if (xTaskCreate(log_task_fn, "uFlake_Log", UFLAKE_LOG_TASK_STACK_SIZE, NULL,
+                    UFLAKE_LOG_TASK_PRIORITY, &log_task) != pdPASS)
+    {
+        ESP_LOGE(TAG, "Failed to create log task");
+        return UFLAKE_ERROR_MEMORY;
+    }
+#endif
 
-    ESP_LOGI(TAG, "Logger initialized with buffer size: %d", (int)log_buffer_size);
+    log_ready = true;
+    ESP_LOGI(TAG, "Logger initialized with buffer size: %d x %d cores (%s)", (int)UFLAKE_LOG_RING_SIZE,
+             portNUM_PROCESSORS, UFLAKE_LOG_DEFERRED ? "deferred" : "immediate");
     return UFLAKE_OK;
 }
 
@@ -40,40 +657,57 @@ void uflake_log(log_level_t level, const char *tag, const char *format, ...)
         return;
     }
 
-    if (!log_buffer)
+    if (!log_ready || !format)
     {
         return;
     }
 
-    // ISR-SAFE: Skip mutex in interrupt context
     bool in_isr = uflake_kernel_is_in_isr();
 
-    if (!in_isr && log_mutex)
-    {
-        xSemaphoreTake(log_mutex, portMAX_DELAY);
-    }
+    // Reserve a slot on this core's ring. A task that migrates right after
+    // reading the core ID still owns the slot it reserved.
+    log_ring_t *ring = &log_rings[xPortGetCoreID()];
+    uint32_t n = __atomic_fetch_add(&ring->head, 1, __ATOMIC_RELAXED);
+    log_record_t *entry = &ring->records[n & (UFLAKE_LOG_RING_SIZE - 1)];
 
-    log_entry_t *entry = &log_buffer[log_buffer_index];
-    entry->timestamp = in_isr ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
-    entry->level = level;
+    __atomic_store_n(&entry->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
 
-    strncpy(entry->tag, tag, sizeof(entry->tag) - 1);
-    entry->tag[sizeof(entry->tag) - 1] = '\0';
+    entry->timestamp_us = esp_timer_get_time();
+    entry->format = format;
+    entry->level = (uint8_t)level;
+    entry->tag_id = log_tag_id(tag ? tag : "?");
 
     va_list args;
     va_start(args, format);
-    vsnprintf(entry->message, sizeof(entry->message), format, args);
+    log_capture_args(entry, format, args);
     va_end(args);
 
-    log_buffer_index = (log_buffer_index + 1) % log_buffer_size;
+    // Commit - readers only take records whose seq matches their position
+    __atomic_store_n(&entry->seq, n + 1, __ATOMIC_RELEASE);
 
-    if (!in_isr && log_mutex)
+#if UFLAKE_LOG_DEFERRED
+    // One wakeup per batch - the log task clears the flag before draining
+    if (log_task && !log_drain_pending)
     {
-        xSemaphoreGive(log_mutex);
+        log_drain_pending = true;
+        if (in_isr)
+        {
+            BaseType_t woken = pdFALSE;
+            vTaskNotifyGiveFromISR(log_task, &woken);
+            portYIELD_FROM_ISR(woken);
+        }
+        else
+        {
+            xTaskNotifyGive(log_task);
+        }
     }
-
-    // Also output to ESP-IDF log system
-    ESP_LOG_LEVEL_LOCAL((esp_log_level_t)level, tag, "%s", entry->message);
+#else
+    if (!in_isr)
+    {
+        log_drain();
+    }
+#endif
 }
 
 uflake_result_t uflake_log_set_level(log_level_t level)
@@ -90,17 +724,262 @@ uflake_result_t uflake_log_set_level(log_level_t level)
 
 uflake_result_t uflake_log_get_entries(log_entry_t *entries, size_t *count)
 {
+    uflake_log_cursor_t cursor;
+
     if (!entries || !count)
     {
         return UFLAKE_ERROR_INVALID_PARAM;
     }
 
+    // A throwaway cursor at the oldest record - formatting happens here,
+    // outside any writer's path
+    uflake_log_cursor_init(&cursor, true);
+    return uflake_log_read(&cursor, NULL, entries, count, NULL);
+}
+
+uflake_result_t uflake_log_cursor_init(uflake_log_cursor_t *cursor, bool from_oldest)
+{
+    if (!cursor)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        uint32_t head = log_ready ? __atomic_load_n(&log_rings[core].head, __ATOMIC_ACQUIRE) : 0;
+        if (from_oldest)
+            cursor->pos[core] = (head > UFLAKE_LOG_RING_SIZE) ? head - UFLAKE_LOG_RING_SIZE : 0;
+        else
+            cursor->pos[core] = head;
+    }
+    cursor->dropped = 0;
+    return UFLAKE_OK;
+}
+
+static bool log_filter_match(const log_record_t *record, log_level_t max_level, const char *tag)
+{
+    if (record->level > max_level)
+        return false;
+
+    // Interned names are cut to 15 characters
+    return !tag || !tag[0] || strncmp(log_tag_name(record->tag_id), tag, sizeof(log_tag_names[0]) - 1) == 0;
+}
+
+uflake_result_t uflake_log_read(uflake_log_cursor_t *cursor, const uflake_log_filter_t *filter,
+                                log_entry_t *entries, size_t *count, uint32_t *dropped)
+{
+    if (!cursor || !entries || !count)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    log_level_t max_level = filter ? filter->max_level : LOG_LEVEL_VERBOSE;
+    const char *tag = filter ? filter->tag : NULL;
+    uint32_t lost = 0;
+    size_t copied = 0;
+    log_record_t record;
+
+    // Filtered-out records are passed over unformatted
+    while (copied < *count && log_ready && log_read_next(cursor->pos, &record, &lost))
+    {
+        if (log_filter_match(&record, max_level, tag))
+            log_record_to_entry(&record, &entries[copied++]);
+    }
+
+    *count = copied;
+    cursor->dropped += lost;
+    if (dropped)
+        *dropped = lost;
+    return UFLAKE_OK;
+}
+
+void uflake_log_flush(void)
+{
+    if (!log_ready || uflake_kernel_is_in_isr())
+        return;
+
+    log_drain();
+}
+
+uint32_t uflake_log_get_dropped(void)
+{
+    return log_dropped;
+}
+
+// Write everything the stream cursor has not seen, a batch at a time
+static void log_stream_write_pending(uflake_log_cursor_t *cursor)
+{
+    log_record_t record;
+    char message[LOG_MESSAGE_LEN];
+    bool more = true;
+
+    while (more)
+    {
+        size_t used = 0;
+        size_t lines = 0;
+        uint32_t lost = 0;
+
+        more = false;
+        while (lines < UFLAKE_LOG_STREAM_BATCH)
+        {
+            if (!log_read_next(cursor->pos, &record, &lost))
+                break;
+            more = true;
+
+            if (!log_filter_match(&record, log_stream.max_level, log_stream.tag))
+                continue;
+
+            log_format_record(&record, message, sizeof(message));
+            int written = snprintf(log_stream.batch + used, LOG_STREAM_LINE_LEN, "%c (%lu) %s: %s\n",
+                                   log_level_letters[record.level], (unsigned long)(record.timestamp_us / 1000),
+                                   log_tag_name(record.tag_id), message);
+            used += (written < 0) ? 0 : ((written < LOG_STREAM_LINE_LEN) ? (size_t)written : LOG_STREAM_LINE_LEN - 1);
+            lines++;
+        }
+
+        if (lost)
+        {
+            // Said before the batch it precedes - the gap came first
+            char gap[48];
+            int written = snprintf(gap, sizeof(gap), "-- %lu log records dropped --\n", (unsigned long)lost);
+            log_stream.writer(gap, (size_t)written, log_stream.ctx);
+            cursor->dropped += lost;
+        }
+
+        if (used)
+            log_stream.writer(log_stream.batch, used, log_stream.ctx);
+    }
+
+    if (log_stream.file)
+        fflush(log_stream.file);
+}
+
+static void log_stream_task_fn(void *args)
+{
+    uflake_log_cursor_t cursor;
+    uflake_log_cursor_init(&cursor, true);
+
+    while (!log_stream.stop)
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(UFLAKE_LOG_STREAM_PERIOD_MS));
+        log_stream_write_pending(&cursor);
+    }
+
+    log_stream_write_pending(&cursor);
+    if (log_stream.file)
+        fclose(log_stream.file);
+    uflake_free(log_stream.batch);
+
+    ESP_LOGI(TAG, "Log stream stopped (%lu records dropped)", (unsigned long)cursor.dropped);
+    log_stream.file = NULL;
+    log_stream.batch = NULL;
+    log_stream.task = NULL;
+    vTaskDelete(NULL);
+}
+
+static uflake_result_t log_stream_start(uflake_log_writer_t writer, void *ctx, FILE *file,
+                                        const uflake_log_filter_t *filter)
+{
+    if (!log_ready)
+        return UFLAKE_ERROR;
+
     xSemaphoreTake(log_mutex, portMAX_DELAY);
 
-    size_t copy_count = (*count < log_buffer_size) ? *count : log_buffer_size;
-    memcpy(entries, log_buffer, sizeof(log_entry_t) * copy_count);
-    *count = copy_count;
+    if (log_stream.task)
+    {
+        xSemaphoreGive(log_mutex);
+        ESP_LOGW(TAG, "A log stream is already running");
+        return UFLAKE_ERROR;
+    }
+
+    log_stream.batch = (char *)uflake_malloc(UFLAKE_LOG_STREAM_BATCH * LOG_STREAM_LINE_LEN, UFLAKE_MEM_INTERNAL);
+    if (!log_stream.batch)
+    {
+        xSemaphoreGive(log_mutex);
+        ESP_LOGE(TAG, "Failed to allocate log stream buffer");
+        return UFLAKE_ERROR_MEMORY;
+    }
+
+    log_stream.writer = writer;
+    log_stream.ctx = ctx;
+    log_stream.file = file;
+    log_stream.max_level = filter ? filter->max_level : LOG_LEVEL_VERBOSE;
+    log_stream.tag[0] = '\0';
+    if (filter && filter->tag)
+    {
+        strncpy(log_stream.tag, filter->tag, sizeof(log_stream.tag) - 1);
+        log_stream.tag[sizeof(log_stream.tag) - 1] = '\0';
+    }
+    log_stream.stop = false;
+
+    if (xTaskCreate(log_stream_task_fn, "uFlake_LogStream", UFLAKE_LOG_STREAM_STACK_SIZE, NULL,
+                    UFLAKE_LOG_STREAM_PRIORITY, &log_stream.task) != pdPASS)
+    {
+        uflake_free(log_stream.batch);
+        log_stream.batch = NULL;
+        log_stream.task = NULL;
+        xSemaphoreGive(log_mutex);
+        ESP_LOGE(TAG, "Failed to create log stream task");
+        return UFLAKE_ERROR_MEMORY;
+    }
 
     xSemaphoreGive(log_mutex);
     return UFLAKE_OK;
 }
+
+uflake_result_t uflake_log_stream_start(uflake_log_writer_t writer, void *ctx, const uflake_log_filter_t *filter)
+{
+    if (!writer)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    return log_stream_start(writer, ctx, NULL, filter);
+}
+
+static size_t log_file_writer(const void *data, size_t size, void *ctx)
+{
+    return fwrite(data, 1, size, (FILE *)ctx);
+}
+
+uflake_result_t uflake_log_stream_start_file(const char *path, const uflake_log_filter_t *filter)
+{
+    if (!path)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    FILE *file = fopen(path, "a");
+    if (!file)
+    {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        return UFLAKE_ERROR_NOT_FOUND;
+    }
+
+    uflake_result_t result = log_stream_start(log_file_writer, file, file, filter);
+    if (result != UFLAKE_OK)
+        fclose(file);
+    return result;
+}
+
+static size_t log_uart_writer(const void *data, size_t size, void *ctx)
+{
+    int written = uart_write_bytes((uart_port_t)(intptr_t)ctx, data, size);
+    return (written < 0) ? 0 : (size_t)written;
+}
+
+uflake_result_t uflake_log_stream_start_uart(int uart_port, const uflake_log_filter_t *filter)
+{
+    if (uart_port < 0 || uart_port >= UART_NUM_MAX)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    return log_stream_start(log_uart_writer, (void *)(intptr_t)uart_port, NULL, filter);
+}
+
+void uflake_log_stream_stop(void)
+{
+    TaskHandle_t task = log_stream.task;
+    if (!task || uflake_kernel_is_in_isr())
+        return;
+
+    log_stream.stop = true;
+    xTaskNotifyGive(task);
+
+    // The task writes the last batch and clears its handle on the way out
+    for (int i = 0; i < 100 && log_stream.task; i++)
+    {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
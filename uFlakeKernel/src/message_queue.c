@@ -1,18 +1,18 @@
 #include "message_queue.h"
 #include "memory_manager.h"
+#include "coroutine.h"
 #include "esp_log.h"
 
 static const char *TAG = "MSG_QUEUE";
 static uflake_msgqueue_t *queue_list = NULL;
-static SemaphoreHandle_t msgqueue_mutex = NULL;
-static uint32_t next_message_id = 1;
+static uflake_rwlock_t *queue_list_lock = NULL; // lookups share it, create/destroy own it
+static uint32_t next_message_id = 1;            // atomic - bumped from tasks and ISRs
 
 uflake_result_t uflake_messagequeue_init(void)
 {
-    msgqueue_mutex = xSemaphoreCreateMutex();
-    if (!msgqueue_mutex)
+    if (uflake_rwlock_create_named(&queue_list_lock, "msgqueue") != UFLAKE_OK)
     {
-        ESP_LOGE(TAG, "Failed to create message queue mutex");
+        ESP_LOGE(TAG, "Failed to create message queue list lock");
         return UFLAKE_ERROR_MEMORY;
     }
 
@@ -26,7 +26,7 @@ uflake_result_t uflake_msgqueue_create(const char *name, uint32_t max_messages,
     if (!name || !queue || max_messages == 0)
         return UFLAKE_ERROR_INVALID_PARAM;
 
-    xSemaphoreTake(msgqueue_mutex, portMAX_DELAY);
+    uflake_rwlock_write_lock(queue_list_lock, UINT32_MAX);
 
     // Check if queue with same name already exists
     uflake_msgqueue_t *existing = queue_list;
@@ -34,7 +34,7 @@ uflake_result_t uflake_msgqueue_create(const char *name, uint32_t max_messages,
     {
         if (strcmp(existing->name, name) == 0)
         {
-            xSemaphoreGive(msgqueue_mutex);
+            uflake_rwlock_write_unlock(queue_list_lock);
             return UFLAKE_ERROR;
         }
         existing = existing->next;
@@ -43,7 +43,7 @@ uflake_result_t uflake_msgqueue_create(const char *name, uint32_t max_messages,
     uflake_msgqueue_t *new_queue = (uflake_msgqueue_t *)uflake_malloc(sizeof(uflake_msgqueue_t), UFLAKE_MEM_INTERNAL);
     if (!new_queue)
     {
-        xSemaphoreGive(msgqueue_mutex);
+        uflake_rwlock_write_unlock(queue_list_lock);
         return UFLAKE_ERROR_MEMORY;
     }
 
@@ -51,7 +51,7 @@ uflake_result_t uflake_msgqueue_create(const char *name, uint32_t max_messages,
     if (!new_queue->queue_handle)
     {
         uflake_free(new_queue);
-        xSemaphoreGive(msgqueue_mutex);
+        uflake_rwlock_write_unlock(queue_list_lock);
         return UFLAKE_ERROR_MEMORY;
     }
 
@@ -60,6 +60,7 @@ uflake_result_t uflake_msgqueue_create(const char *name, uint32_t max_messages,
     new_queue->max_messages = max_messages;
     new_queue->message_count = 0;
     new_queue->is_public = is_public;
+    new_queue->coro_waiters = 0;
 
     uflake_process_t *current_process = uflake_process_get_current();
     new_queue->owner_pid = current_process ? current_process->pid : 0;
@@ -70,7 +71,7 @@ uflake_result_t uflake_msgqueue_create(const char *name, uint32_t max_messages,
 
     *queue = new_queue;
 
-    xSemaphoreGive(msgqueue_mutex);
+    uflake_rwlock_write_unlock(queue_list_lock);
     ESP_LOGI(TAG, "Created message queue '%s' with %d max messages", name, (int)max_messages);
 
     return UFLAKE_OK;
@@ -86,34 +87,38 @@ uflake_result_t uflake_msgqueue_send(uflake_msgqueue_t *queue, const uflake_mess
 
     if (uflake_kernel_is_in_isr())
     {
-        msg_copy.message_id = next_message_id++;
+        msg_copy.message_id = __atomic_fetch_add(&next_message_id, 1, __ATOMIC_RELAXED);
         msg_copy.timestamp = xTaskGetTickCountFromISR();
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
         if (xQueueSendFromISR(queue->queue_handle, &msg_copy, &xHigherPriorityTaskWoken) == pdTRUE)
         {
-            //  Atomic increment (single instruction on ESP32)
-            queue->message_count++;
+            __atomic_fetch_add(&queue->message_count, 1, __ATOMIC_RELAXED);
+            uflake_kernel_trace_record(KERNEL_TRACE_QUEUE_SEND, queue->name, (uint32_t)msg_copy.data_size);
+            if (queue->coro_waiters)
+            {
+                uflake_coro_notify_from_isr(&xHigherPriorityTaskWoken);
+            }
             portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
             return UFLAKE_OK;
         }
         return UFLAKE_ERROR_TIMEOUT;
     }
 
-    // Protect message ID and count together
-    xSemaphoreTake(msgqueue_mutex, portMAX_DELAY);
-    msg_copy.message_id = next_message_id++;
+    msg_copy.message_id = __atomic_fetch_add(&next_message_id, 1, __ATOMIC_RELAXED);
     msg_copy.timestamp = uflake_kernel_get_tick_count();
-    xSemaphoreGive(msgqueue_mutex);
 
     TickType_t timeout_ticks = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
 
     if (xQueueSend(queue->queue_handle, &msg_copy, timeout_ticks) == pdTRUE)
     {
-        xSemaphoreTake(msgqueue_mutex, portMAX_DELAY);
-        queue->message_count++;
-        xSemaphoreGive(msgqueue_mutex);
+        __atomic_fetch_add(&queue->message_count, 1, __ATOMIC_RELAXED);
 
+        uflake_kernel_trace_record(KERNEL_TRACE_QUEUE_SEND, queue->name, (uint32_t)msg_copy.data_size);
+        if (queue->coro_waiters)
+        {
+            uflake_coro_notify();
+        }
         ESP_LOGD(TAG, "Message sent to queue '%s', ID: %d", queue->name, (int)msg_copy.message_id);
         return UFLAKE_OK;
     }
@@ -130,7 +135,8 @@ uflake_result_t uflake_msgqueue_receive_from_isr(uflake_msgqueue_t *queue, uflak
 
     if (xQueueReceiveFromISR(queue->queue_handle, message, &xHigherPriorityTaskWoken) == pdTRUE)
     {
-        queue->message_count--; // Atomic decrement
+        __atomic_fetch_sub(&queue->message_count, 1, __ATOMIC_RELAXED);
+        uflake_kernel_trace_record(KERNEL_TRACE_QUEUE_RECEIVE, queue->name, (uint32_t)message->data_size);
         portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
         return UFLAKE_OK;
     }
@@ -153,13 +159,15 @@ uflake_result_t uflake_msgqueue_receive(uflake_msgqueue_t *queue, uflake_message
 
     if (xQueueReceive(queue->queue_handle, message, timeout_ticks) == pdTRUE)
     {
-        xSemaphoreTake(msgqueue_mutex, portMAX_DELAY);
-        if (queue->message_count > 0)
+        // Never wrap below zero if the periodic resync raced a receive
+        uint32_t count = __atomic_load_n(&queue->message_count, __ATOMIC_RELAXED);
+        while (count > 0 &&
+               !__atomic_compare_exchange_n(&queue->message_count, &count, count - 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
         {
-            queue->message_count--;
         }
-        xSemaphoreGive(msgqueue_mutex);
 
+        uflake_kernel_trace_record(KERNEL_TRACE_QUEUE_RECEIVE, queue->name, (uint32_t)message->data_size);
         ESP_LOGD(TAG, "Message received from queue '%s', ID: %d", queue->name, (int)message->message_id);
         return UFLAKE_OK;
     }
@@ -172,17 +180,17 @@ uflake_result_t uflake_msgqueue_broadcast(const uflake_message_t *message)
     if (!message)
         return UFLAKE_ERROR_INVALID_PARAM;
 
-    xSemaphoreTake(msgqueue_mutex, portMAX_DELAY);
+    uflake_rwlock_read_lock(queue_list_lock, UINT32_MAX);
 
     uflake_message_t broadcast_msg = *message;
     broadcast_msg.type = MSG_TYPE_BROADCAST;
-    broadcast_msg.message_id = next_message_id++;
+    broadcast_msg.message_id = __atomic_fetch_add(&next_message_id, 1, __ATOMIC_RELAXED);
     broadcast_msg.timestamp = uflake_kernel_get_tick_count();
 
     // Send to all public queues (simplified implementation)
     // In a real implementation, you'd maintain a proper list of queues
 
-    xSemaphoreGive(msgqueue_mutex);
+    uflake_rwlock_read_unlock(queue_list_lock);
     ESP_LOGI(TAG, "Broadcast message sent, ID: %d", (int)broadcast_msg.message_id);
 
     return UFLAKE_OK;
@@ -193,7 +201,7 @@ uflake_result_t uflake_msgqueue_find(const char *name, uflake_msgqueue_t **queue
     if (!name || !queue)
         return UFLAKE_ERROR_INVALID_PARAM;
 
-    xSemaphoreTake(msgqueue_mutex, portMAX_DELAY);
+    uflake_rwlock_read_lock(queue_list_lock, UINT32_MAX);
 
     uflake_msgqueue_t *current = queue_list;
     while (current)
@@ -201,13 +209,13 @@ uflake_result_t uflake_msgqueue_find(const char *name, uflake_msgqueue_t **queue
         if (strcmp(current->name, name) == 0)
         {
             *queue = current;
-            xSemaphoreGive(msgqueue_mutex);
+            uflake_rwlock_read_unlock(queue_list_lock);
             return UFLAKE_OK;
         }
         current = current->next;
     }
 
-    xSemaphoreGive(msgqueue_mutex);
+    uflake_rwlock_read_unlock(queue_list_lock);
     return UFLAKE_ERROR_NOT_FOUND;
 }
 
@@ -216,7 +224,7 @@ uflake_result_t uflake_msgqueue_destroy(uflake_msgqueue_t *queue)
     if (!queue)
         return UFLAKE_ERROR_INVALID_PARAM;
 
-    xSemaphoreTake(msgqueue_mutex, portMAX_DELAY);
+    uflake_rwlock_write_lock(queue_list_lock, UINT32_MAX);
 
     uflake_msgqueue_t *prev = NULL;
     uflake_msgqueue_t *current = queue_list;
@@ -234,28 +242,34 @@ uflake_result_t uflake_msgqueue_destroy(uflake_msgqueue_t *queue)
                 queue_list = current->next;
             }
 
+            // Coroutines awaiting this queue resume with an error instead of polling freed memory
+            if (__atomic_load_n(&queue->coro_waiters, __ATOMIC_RELAXED))
+            {
+                uflake_coro_queue_destroyed(queue);
+            }
+
             if (queue->queue_handle)
             {
                 vQueueDelete(queue->queue_handle);
             }
 
+            ESP_LOGI(TAG, "Destroyed message queue '%s'", queue->name);
             uflake_free(queue);
 
-            xSemaphoreGive(msgqueue_mutex);
-            ESP_LOGI(TAG, "Destroyed message queue '%s'", queue->name);
+            uflake_rwlock_write_unlock(queue_list_lock);
             return UFLAKE_OK;
         }
         prev = current;
         current = current->next;
     }
 
-    xSemaphoreGive(msgqueue_mutex);
+    uflake_rwlock_write_unlock(queue_list_lock);
     return UFLAKE_ERROR_NOT_FOUND;
 }
 
 void uflake_messagequeue_process(void)
 {
-    if (!msgqueue_mutex)
+    if (!queue_list_lock)
         return;
 
     static uint32_t last_cleanup_tick = 0;
@@ -270,7 +284,7 @@ void uflake_messagequeue_process(void)
     last_cleanup_tick = current_tick;
 
     // Use timeout to prevent deadlock
-    if (xSemaphoreTake(msgqueue_mutex, pdMS_TO_TICKS(10)) != pdTRUE)
+    if (uflake_rwlock_read_lock(queue_list_lock, 10) != UFLAKE_OK)
         return;
 
     uflake_msgqueue_t *current = queue_list;
@@ -302,13 +316,13 @@ void uflake_messagequeue_process(void)
         {
             ESP_LOGW(TAG, "Queue '%s' count mismatch - correcting from %d to %d",
                      current->name, (int)current->message_count, (int)actual_count);
-            current->message_count = actual_count;
+            __atomic_store_n(&current->message_count, (uint32_t)actual_count, __ATOMIC_RELAXED);
         }
 
         current = current->next;
     }
 
-    xSemaphoreGive(msgqueue_mutex);
+    uflake_rwlock_read_unlock(queue_list_lock);
 
     // Log statistics periodically
     ESP_LOGD(TAG, "Message Queue Stats: %d queues, %d total messages, %d empty",
@@ -30,6 +30,9 @@ void uflake_panic_trigger(panic_reason_t reason, const char *message)
 
     panic_occurred = true;
 
+    // Print deferred log lines first so the banner is the last thing on the console
+    uflake_log_flush();
+
     ESP_LOGE(TAG, "╔════════════════════════════════════════════════════════════╗");
     ESP_LOGE(TAG, "║                    KERNEL PANIC                            ║");
     ESP_LOGE(TAG, "╠════════════════════════════════════════════════════════════╣");
@@ -2,23 +2,70 @@
 #include "memory_manager.h"
 #include "esp_log.h"
 #include "esp_task_wdt.h"
+#include "esp_timer.h"
 
 static const char *TAG = "SCHEDULER";
 static uflake_process_t *process_list = NULL;
 static uint32_t next_pid = 1;
 static SemaphoreHandle_t scheduler_mutex = NULL;
+static int64_t stack_last_sample_us = 0;
 
-uflake_result_t uflake_scheduler_init(void)
+#define SCHEDULER_CPU_ACCOUNTING ((configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1))
+
+#if SCHEDULER_CPU_ACCOUNTING
+// CPU accounting - run-time counters from the previous sample, matched by task
+// handle and task number: pooled and heap TCB addresses are reused, so the
+// handle alone can pair a relaunched task with its predecessor's counter
+typedef struct
 {
-    scheduler_mutex = xSemaphoreCreateMutex();
-    if (!scheduler_mutex)
+    TaskHandle_t handle;
+    UBaseType_t task_number;
+    uint32_t run_counter;
+} cpu_sample_t;
+
+static TaskStatus_t *cpu_status = NULL;
+static cpu_sample_t cpu_prev[UFLAKE_CPU_MAX_TASKS];
+static uint32_t cpu_prev_count = 0;
+static int64_t cpu_last_sample_us = 0;
+#endif
+
+// Last completed window, guarded by scheduler_mutex
+static uflake_cpu_snapshot_t cpu_snapshot = {0};
+static bool cpu_snapshot_valid = false;
+
+struct uflake_periodic_t
+{
+    periodic_job_t job;
+    void *args;
+    esp_timer_handle_t release_alarm;
+    TaskHandle_t task;
+    portMUX_TYPE stats_lock;
+    uint64_t response_total_us;
+    uint64_t jitter_total_us;
+    uflake_periodic_stats_t stats;
+    struct uflake_periodic_t *live_next; // periodic_live chain
+};
+
+// Periodic states whose process still exists. The alarm service may already
+// have dispatched a release callback when a process goes away, so the
+// callback looks its argument up here under periodic_lock instead of
+// dereferencing it, and a state is unlinked before its task is deleted.
+static uflake_periodic_t *periodic_live = NULL;
+static portMUX_TYPE periodic_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void periodic_retire(uflake_periodic_t *periodic)
+{
+    portENTER_CRITICAL_SAFE(&periodic_lock);
+    uflake_periodic_t **link = &periodic_live;
+    while (*link && *link != periodic)
     {
-        ESP_LOGE(TAG, "Failed to create scheduler mutex");
-        return UFLAKE_ERROR_MEMORY;
+        link = &(*link)->live_next;
     }
-
-    ESP_LOGI(TAG, "Scheduler initialized");
-    return UFLAKE_OK;
+    if (*link)
+    {
+        *link = periodic->live_next;
+    }
+    portEXIT_CRITICAL_SAFE(&periodic_lock);
 }
 
 // Wrapper data to pass both process and entry point
@@ -29,6 +76,249 @@ typedef struct
     void *args;
 } process_wrapper_args_t;
 
+// Static process pool. A slot is reusable once its PCB has been unlinked
+// (pcb_in_use, cleared under scheduler_mutex) and FreeRTOS has finished with
+// its TCB (task_alive, cleared by vPortCleanUpTCB - possibly much later, from
+// the idle task, when a task deleted itself or ran on the other core).
+#define PROCESS_POOL_SLOTS (UFLAKE_PROCESS_POOL_4K_SLOTS + UFLAKE_PROCESS_POOL_8K_SLOTS + UFLAKE_PROCESS_POOL_16K_SLOTS)
+#define PROCESS_POOL_STACK_BYTES (UFLAKE_PROCESS_POOL_4K_SLOTS * 4096 + \
+                                  UFLAKE_PROCESS_POOL_8K_SLOTS * 8192 + \
+                                  UFLAKE_PROCESS_POOL_16K_SLOTS * 16384)
+
+typedef struct
+{
+    StaticTask_t tcb;
+    uflake_process_t pcb;
+    process_wrapper_args_t wrapper_args;
+    StackType_t *stack;
+    size_t stack_size;
+    bool pcb_in_use;
+    bool task_alive;
+} process_pool_slot_t;
+
+static StackType_t process_pool_stacks[PROCESS_POOL_STACK_BYTES / sizeof(StackType_t)] __attribute__((aligned(16)));
+static process_pool_slot_t process_pool[PROCESS_POOL_SLOTS]; // Ordered by stack size
+static portMUX_TYPE process_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Processes terminated by another task. vTaskDelete() can return while the
+// task is still running on the other core, so a PCB and its periodic state
+// wait here (linked by next, guarded by process_pool_lock) until FreeRTOS
+// releases the TCB - vPortCleanUpTCB clears task_handle - and the scheduler
+// tick frees them.
+static uflake_process_t *process_graveyard = NULL;
+
+static void process_pool_init(void)
+{
+    static const struct
+    {
+        size_t stack_size;
+        uint32_t slots;
+    } classes[] = {
+        {4096, UFLAKE_PROCESS_POOL_4K_SLOTS},
+        {8192, UFLAKE_PROCESS_POOL_8K_SLOTS},
+        {16384, UFLAKE_PROCESS_POOL_16K_SLOTS},
+    };
+
+    uint8_t *stack = (uint8_t *)process_pool_stacks;
+    uint32_t index = 0;
+
+    for (size_t c = 0; c < sizeof(classes) / sizeof(classes[0]); c++)
+    {
+        for (uint32_t i = 0; i < classes[c].slots; i++)
+        {
+            process_pool[index].stack = (StackType_t *)stack;
+            process_pool[index].stack_size = classes[c].stack_size;
+            stack += classes[c].stack_size;
+            index++;
+        }
+    }
+}
+
+// Claim the smallest free slot that fits stack_size (scheduler_mutex held)
+static int process_pool_acquire(size_t stack_size)
+{
+    int found = -1;
+
+    portENTER_CRITICAL(&process_pool_lock);
+    for (int i = 0; i < PROCESS_POOL_SLOTS; i++)
+    {
+        process_pool_slot_t *slot = &process_pool[i];
+        if (slot->stack_size >= stack_size && !slot->pcb_in_use && !slot->task_alive)
+        {
+            slot->pcb_in_use = true;
+            slot->task_alive = true;
+            found = i;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&process_pool_lock);
+
+    return found;
+}
+
+static void process_pool_release_pcb(int index)
+{
+    portENTER_CRITICAL(&process_pool_lock);
+    process_pool[index].pcb_in_use = false;
+    portEXIT_CRITICAL(&process_pool_lock);
+}
+
+// ESP-IDF task clean-up hook (CONFIG_FREERTOS_ENABLE_STATIC_TASK_CLEAN_UP):
+// called for every deleted task once FreeRTOS no longer touches its TCB and stack
+void vPortCleanUpTCB(void *pxTCB)
+{
+    portENTER_CRITICAL_SAFE(&process_pool_lock);
+    for (uflake_process_t *process = process_graveyard; process; process = process->next)
+    {
+        if ((void *)process->task_handle == pxTCB)
+            process->task_handle = NULL;
+    }
+    portEXIT_CRITICAL_SAFE(&process_pool_lock);
+
+    for (int i = 0; i < PROCESS_POOL_SLOTS; i++)
+    {
+        if ((void *)&process_pool[i].tcb == pxTCB)
+        {
+            portENTER_CRITICAL_SAFE(&process_pool_lock);
+            process_pool[i].task_alive = false;
+            uflake_periodic_t *periodic = process_pool[i].pcb_in_use ? process_pool[i].pcb.periodic : NULL;
+            portEXIT_CRITICAL_SAFE(&process_pool_lock);
+
+            // Deleted behind the kernel's back - stop releases before the TCB is reused
+            if (periodic)
+                periodic_retire(periodic);
+            return;
+        }
+    }
+}
+
+// Refresh a process's peak stack use from its FreeRTOS high-water mark
+// (scheduler_mutex held). The mark is the least free stack ever seen, so
+// the peak between samples is never missed.
+static void scheduler_sample_stack(uflake_process_t *process)
+{
+    if (!process->task_handle)
+        return;
+
+    size_t free_bytes = uxTaskGetStackHighWaterMark(process->task_handle) * sizeof(StackType_t);
+    uint32_t used = (process->stack_size > free_bytes) ? (uint32_t)(process->stack_size - free_bytes) : 0;
+    if (used > process->stack_peak)
+    {
+        process->stack_peak = used;
+    }
+}
+
+// Remove a process from process_list (scheduler_mutex held)
+static void scheduler_detach_process(uflake_process_t *process)
+{
+    uflake_process_t **link = &process_list;
+    while (*link && *link != process)
+    {
+        link = &(*link)->next;
+    }
+    if (*link)
+    {
+        *link = process->next;
+    }
+}
+
+// Drop a detached process's memory; its task must no longer run (scheduler_mutex held)
+static void scheduler_free_process(uflake_process_t *process)
+{
+    if (process->periodic)
+    {
+        // Unreachable from release callbacks from here on, so it can be freed
+        periodic_retire(process->periodic);
+        esp_timer_stop(process->periodic->release_alarm);
+        esp_timer_delete(process->periodic->release_alarm);
+        uflake_free(process->periodic);
+        process->periodic = NULL;
+    }
+
+    if (process->pool_slot >= 0)
+    {
+        process_pool_release_pcb(process->pool_slot);
+    }
+    else
+    {
+        uflake_free(process);
+    }
+}
+
+// Remove a process from process_list and drop its memory (scheduler_mutex held)
+static void scheduler_unlink_process(uflake_process_t *process)
+{
+    scheduler_detach_process(process);
+    scheduler_free_process(process);
+}
+
+// Park a process whose task another task is about to delete (scheduler_mutex held)
+static void scheduler_bury_process(uflake_process_t *process)
+{
+    scheduler_detach_process(process);
+
+    // No more releases; the alarm itself goes with the state, once the task is gone
+    if (process->periodic)
+        periodic_retire(process->periodic);
+
+    portENTER_CRITICAL(&process_pool_lock);
+    process->next = process_graveyard;
+    process_graveyard = process;
+    portEXIT_CRITICAL(&process_pool_lock);
+}
+
+// Free buried processes whose TCB FreeRTOS has released (scheduler_mutex held)
+static void scheduler_reap_graveyard(void)
+{
+    while (true)
+    {
+        uflake_process_t *dead = NULL;
+
+        portENTER_CRITICAL(&process_pool_lock);
+        for (uflake_process_t **link = &process_graveyard; *link; link = &(*link)->next)
+        {
+            if (!(*link)->task_handle)
+            {
+                dead = *link;
+                *link = dead->next;
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&process_pool_lock);
+
+        if (!dead)
+            break;
+        scheduler_free_process(dead);
+    }
+}
+
+uflake_result_t uflake_scheduler_init(void)
+{
+    scheduler_mutex = xSemaphoreCreateMutex();
+    if (!scheduler_mutex)
+    {
+        ESP_LOGE(TAG, "Failed to create scheduler mutex");
+        return UFLAKE_ERROR_MEMORY;
+    }
+
+#if SCHEDULER_CPU_ACCOUNTING
+    cpu_status = (TaskStatus_t *)uflake_malloc(sizeof(TaskStatus_t) * UFLAKE_CPU_MAX_TASKS, UFLAKE_MEM_INTERNAL);
+    if (!cpu_status)
+    {
+        ESP_LOGE(TAG, "Failed to allocate CPU accounting buffer");
+        return UFLAKE_ERROR_MEMORY;
+    }
+#else
+    ESP_LOGW(TAG, "FreeRTOS run-time stats disabled - CPU accounting unavailable");
+#endif
+
+    process_pool_init();
+
+    ESP_LOGI(TAG, "Scheduler initialized (%d pooled process slots, %d KB)",
+             PROCESS_POOL_SLOTS, PROCESS_POOL_STACK_BYTES / 1024);
+    return UFLAKE_OK;
+}
+
 static void process_wrapper(void *args)
 {
     process_wrapper_args_t *wrapper_args = (process_wrapper_args_t *)args;
@@ -38,8 +328,14 @@ static void process_wrapper(void *args)
 
     ESP_LOGI(TAG, "Process %s (PID: %d) started", process->name, (int)process->pid);
 
-    // Free wrapper args now that we've extracted everything
-    uflake_free(wrapper_args);
+    // Free wrapper args now that we've extracted everything (pooled ones live in the slot)
+    if (process->pool_slot < 0)
+    {
+        uflake_free(wrapper_args);
+    }
+
+    // Lets uflake_process_get_current() resolve this task without a lookup
+    vTaskSetThreadLocalStoragePointer(NULL, UFLAKE_PROCESS_TLS_INDEX, process);
 
     process->state = PROCESS_STATE_RUNNING;
 
@@ -49,22 +345,107 @@ static void process_wrapper(void *args)
     // Mark as terminated (no watchdog cleanup needed)
     process->state = PROCESS_STATE_TERMINATED;
     ESP_LOGI(TAG, "Process %s (PID: %d) terminated", process->name, (int)process->pid);
+
+    // Unlink before the task goes away; a pooled slot is reused only after
+    // FreeRTOS has also released the TCB (vPortCleanUpTCB)
+    xSemaphoreTake(scheduler_mutex, portMAX_DELAY);
+    scheduler_sample_stack(process);
+    ESP_LOGD(TAG, "Process %s peak stack %u / %u bytes", process->name,
+             (unsigned)process->stack_peak, (unsigned)process->stack_size);
+    vTaskSetThreadLocalStoragePointer(NULL, UFLAKE_PROCESS_TLS_INDEX, NULL);
+    scheduler_unlink_process(process);
+    xSemaphoreGive(scheduler_mutex);
+
     vTaskDelete(NULL);
 }
 
+// Pick the core for PROCESS_AFFINITY_AUTO (scheduler_mutex held)
+static BaseType_t scheduler_pick_core(void)
+{
+    if (portNUM_PROCESSORS < 2)
+        return 0;
+
+    // Measured load first - a 5% margin keeps near-equal cores on the tie-break
+    if (cpu_snapshot_valid)
+    {
+        int diff = (int)cpu_snapshot.core_load_permille[0] - (int)cpu_snapshot.core_load_permille[1];
+        if (diff > 50)
+            return 1;
+        if (diff < -50)
+            return 0;
+    }
+
+    // Tie-break / no sample yet: fewer processes already pinned there
+    int pinned[2] = {0, 0};
+    for (uflake_process_t *p = process_list; p; p = p->next)
+    {
+        if (p->core == 0 || p->core == 1)
+            pinned[p->core]++;
+    }
+    return (pinned[1] < pinned[0]) ? 1 : 0;
+}
+
+static BaseType_t scheduler_resolve_core(process_affinity_t affinity)
+{
+    switch (affinity)
+    {
+    case PROCESS_AFFINITY_CORE0:
+        return 0;
+    case PROCESS_AFFINITY_CORE1:
+        return (portNUM_PROCESSORS > 1) ? 1 : 0;
+    case PROCESS_AFFINITY_AUTO:
+        return scheduler_pick_core();
+    case PROCESS_AFFINITY_ANY:
+    default:
+        return tskNO_AFFINITY;
+    }
+}
+
 uflake_result_t uflake_process_create(const char *name, process_entry_t entry, void *args,
                                       size_t stack_size, process_priority_t priority, uint32_t *pid)
 {
-    if (!name || !entry)
+    return uflake_process_create_ex(name, entry, args, stack_size, priority, PROCESS_AFFINITY_ANY, pid);
+}
+
+// periodic is owned by the PCB once creation succeeded
+static uflake_result_t scheduler_create_process(const char *name, process_entry_t entry, void *args,
+                                                size_t stack_size, process_priority_t priority,
+                                                process_affinity_t affinity, uflake_periodic_t *periodic,
+                                                uint32_t *pid)
+{
+    if (!name || !entry || affinity > PROCESS_AFFINITY_AUTO)
         return UFLAKE_ERROR_INVALID_PARAM;
 
     xSemaphoreTake(scheduler_mutex, portMAX_DELAY);
 
-    uflake_process_t *process = (uflake_process_t *)uflake_malloc(sizeof(uflake_process_t), UFLAKE_MEM_INTERNAL);
-    if (!process)
+    // Pooled slot first - allocation-free launch; heap for big stacks or a full pool
+    uflake_process_t *process;
+    process_wrapper_args_t *wrapper_args;
+    int pool_slot = process_pool_acquire(stack_size);
+
+    if (pool_slot >= 0)
     {
-        xSemaphoreGive(scheduler_mutex);
-        return UFLAKE_ERROR_MEMORY;
+        process = &process_pool[pool_slot].pcb;
+        wrapper_args = &process_pool[pool_slot].wrapper_args;
+        memset(process, 0, sizeof(*process));
+    }
+    else
+    {
+        process = (uflake_process_t *)uflake_malloc(sizeof(uflake_process_t), UFLAKE_MEM_INTERNAL);
+        if (!process)
+        {
+            xSemaphoreGive(scheduler_mutex);
+            return UFLAKE_ERROR_MEMORY;
+        }
+
+        // Create wrapper args to pass both process and entry point
+        wrapper_args = (process_wrapper_args_t *)uflake_malloc(sizeof(process_wrapper_args_t), UFLAKE_MEM_INTERNAL);
+        if (!wrapper_args)
+        {
+            uflake_free(process);
+            xSemaphoreGive(scheduler_mutex);
+            return UFLAKE_ERROR_MEMORY;
+        }
     }
 
     // Initialize process
@@ -73,51 +454,358 @@ uflake_result_t uflake_process_create(const char *name, process_entry_t entry, v
     process->name[sizeof(process->name) - 1] = '\0';
     process->state = PROCESS_STATE_CREATED;
     process->priority = priority;
-    process->stack_size = stack_size;
-    process->cpu_time = 0;
+    process->affinity = affinity;
+    process->stack_size = (pool_slot >= 0) ? process_pool[pool_slot].stack_size : stack_size;
+    process->stack_ptr = (pool_slot >= 0) ? process_pool[pool_slot].stack : NULL;
+    process->stack_peak = 0;
+    process->pool_slot = (int16_t)pool_slot;
+    process->cpu_time_us = 0;
+    process->cpu_permille = 0;
+    process->periodic = periodic;
 
-    // Create wrapper args to pass both process and entry point
-    process_wrapper_args_t *wrapper_args = (process_wrapper_args_t *)uflake_malloc(sizeof(process_wrapper_args_t), UFLAKE_MEM_INTERNAL);
-    if (!wrapper_args)
-    {
-        uflake_free(process);
-        xSemaphoreGive(scheduler_mutex);
-        return UFLAKE_ERROR_MEMORY;
-    }
     wrapper_args->process = process;
     wrapper_args->entry = entry;
     wrapper_args->args = args;
 
+    BaseType_t core = scheduler_resolve_core(affinity);
+    process->core = (core == tskNO_AFFINITY) ? -1 : (int8_t)core;
+
     // Create FreeRTOS task
-    BaseType_t result = xTaskCreate(
-        process_wrapper,
-        process->name,
-        stack_size / sizeof(StackType_t),
-        wrapper_args, // Pass wrapper args, not just process
-        priority + 1, // FreeRTOS priority offset
-        &process->task_handle);
+    BaseType_t result;
+    if (pool_slot >= 0)
+    {
+        process_pool_slot_t *slot = &process_pool[pool_slot];
+        process->task_handle = xTaskCreateStaticPinnedToCore(
+            process_wrapper,
+            process->name,
+            slot->stack_size / sizeof(StackType_t),
+            wrapper_args,
+            priority + 1, // FreeRTOS priority offset
+            slot->stack,
+            &slot->tcb,
+            core);
+        result = process->task_handle ? pdPASS : pdFAIL;
+    }
+    else
+    {
+        result = xTaskCreatePinnedToCore(
+            process_wrapper,
+            process->name,
+            stack_size / sizeof(StackType_t),
+            wrapper_args, // Pass wrapper args, not just process
+            priority + 1, // FreeRTOS priority offset
+            &process->task_handle,
+            core);
+    }
 
     if (result != pdPASS)
     {
-        uflake_free(process);
+        if (pool_slot >= 0)
+        {
+            portENTER_CRITICAL(&process_pool_lock);
+            process_pool[pool_slot].pcb_in_use = false;
+            process_pool[pool_slot].task_alive = false;
+            portEXIT_CRITICAL(&process_pool_lock);
+        }
+        else
+        {
+            uflake_free(wrapper_args);
+            uflake_free(process);
+        }
         xSemaphoreGive(scheduler_mutex);
         return UFLAKE_ERROR_MEMORY;
     }
 
+    if (periodic)
+    {
+        periodic->task = process->task_handle;
+        portENTER_CRITICAL(&periodic_lock);
+        periodic->live_next = periodic_live;
+        periodic_live = periodic;
+        portEXIT_CRITICAL(&periodic_lock);
+    }
+
     // Add to process list
     process->next = process_list;
     process_list = process;
     process->state = PROCESS_STATE_READY;
 
+    // The task may exit and recycle the PCB as soon as the mutex is released
+    uint32_t new_pid = process->pid;
+    int8_t new_core = process->core;
     if (pid)
-        *pid = process->pid;
+        *pid = new_pid;
 
     xSemaphoreGive(scheduler_mutex);
-    ESP_LOGI(TAG, "Created process %s (PID: %d)", name, (int)process->pid);
+    ESP_LOGI(TAG, "Created process %s (PID: %d, core: %d, %s stack)", name, (int)new_pid, (int)new_core,
+             (pool_slot >= 0) ? "pooled" : "heap");
+
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_process_create_ex(const char *name, process_entry_t entry, void *args,
+                                         size_t stack_size, process_priority_t priority,
+                                         process_affinity_t affinity, uint32_t *pid)
+{
+    return scheduler_create_process(name, entry, args, stack_size, priority, affinity, NULL, pid);
+}
+
+static void periodic_release_cb(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+
+    // Notify under the lock, so the task cannot be retired and deleted in between
+    portENTER_CRITICAL(&periodic_lock);
+    for (uflake_periodic_t *periodic = periodic_live; periodic; periodic = periodic->live_next)
+    {
+        if (periodic == arg)
+        {
+            vTaskNotifyGiveFromISR(periodic->task, &woken);
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&periodic_lock);
+
+    if (woken)
+        taskYIELD();
+}
+
+// Block until release_us; the alarm fires no earlier, stray notifications are ignored
+static void periodic_wait_until(uflake_periodic_t *periodic, int64_t release_us)
+{
+    int64_t delay_us = release_us - esp_timer_get_time();
+    if (delay_us <= 0)
+        return;
+
+    esp_timer_start_once(periodic->release_alarm, (uint64_t)delay_us);
+    while (esp_timer_get_time() < release_us)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+static void periodic_process_entry(void *args)
+{
+    uflake_periodic_t *periodic = (uflake_periodic_t *)args;
+    const int64_t period_us = periodic->stats.period_us;
+    int64_t release_us = esp_timer_get_time();
+    bool running = true;
+
+    while (running)
+    {
+        periodic_wait_until(periodic, release_us);
+
+        int64_t start_us = esp_timer_get_time();
+        running = periodic->job(periodic->args);
+        int64_t end_us = esp_timer_get_time();
+
+        uint32_t jitter_us = (uint32_t)(start_us - release_us);
+        uint32_t response_us = (uint32_t)(end_us - release_us);
+
+        // Next phase-aligned release that is still ahead
+        int64_t next_release_us = release_us + period_us;
+        uint32_t skipped = 0;
+        if (next_release_us <= end_us)
+        {
+            skipped = (uint32_t)((end_us - next_release_us) / period_us) + 1;
+            next_release_us += (int64_t)skipped * period_us;
+        }
+
+        portENTER_CRITICAL(&periodic->stats_lock);
+        uflake_periodic_stats_t *stats = &periodic->stats;
+        stats->releases++;
+        stats->skipped_releases += skipped;
+        if (response_us > stats->deadline_us)
+            stats->deadline_misses++;
+        stats->response_last_us = response_us;
+        if (response_us > stats->response_max_us)
+            stats->response_max_us = response_us;
+        if (jitter_us > stats->jitter_max_us)
+            stats->jitter_max_us = jitter_us;
+        periodic->response_total_us += response_us;
+        periodic->jitter_total_us += jitter_us;
+        portEXIT_CRITICAL(&periodic->stats_lock);
+
+        release_us = next_release_us;
+    }
+}
+
+uflake_result_t uflake_process_create_periodic(const char *name, periodic_job_t job, void *args,
+                                               uint32_t period_us, uint32_t deadline_us,
+                                               size_t stack_size, process_priority_t priority,
+                                               process_affinity_t affinity, uint32_t *pid)
+{
+    if (!name || !job || period_us == 0)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    uflake_periodic_t *periodic = (uflake_periodic_t *)uflake_calloc(1, sizeof(uflake_periodic_t), UFLAKE_MEM_INTERNAL);
+    if (!periodic)
+        return UFLAKE_ERROR_MEMORY;
+
+    periodic->job = job;
+    periodic->args = args;
+    portMUX_INITIALIZE(&periodic->stats_lock);
+    periodic->stats.period_us = period_us;
+    periodic->stats.deadline_us = deadline_us ? deadline_us : period_us;
+
+    const esp_timer_create_args_t alarm_args = {
+        .callback = periodic_release_cb,
+        .arg = periodic,
+        .name = "uflake_release"};
+
+    if (esp_timer_create(&alarm_args, &periodic->release_alarm) != ESP_OK)
+    {
+        uflake_free(periodic);
+        return UFLAKE_ERROR;
+    }
+
+    uflake_result_t result = scheduler_create_process(name, periodic_process_entry, periodic, stack_size,
+                                                      priority, affinity, periodic, pid);
+    if (result != UFLAKE_OK)
+    {
+        esp_timer_delete(periodic->release_alarm);
+        uflake_free(periodic);
+        return result;
+    }
 
+    ESP_LOGI(TAG, "Process %s is periodic (period %u us, deadline %u us)", name,
+             (unsigned)period_us, (unsigned)periodic->stats.deadline_us);
     return UFLAKE_OK;
 }
 
+uflake_result_t uflake_process_get_periodic_stats(uint32_t pid, uflake_periodic_stats_t *stats)
+{
+    if (!stats)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    xSemaphoreTake(scheduler_mutex, portMAX_DELAY);
+
+    for (uflake_process_t *current = process_list; current; current = current->next)
+    {
+        if (current->pid != pid)
+            continue;
+
+        uflake_periodic_t *periodic = current->periodic;
+        if (!periodic)
+        {
+            xSemaphoreGive(scheduler_mutex);
+            return UFLAKE_ERROR_INVALID_PARAM;
+        }
+
+        portENTER_CRITICAL(&periodic->stats_lock);
+        *stats = periodic->stats;
+        if (stats->releases)
+        {
+            stats->response_avg_us = (uint32_t)(periodic->response_total_us / stats->releases);
+            stats->jitter_avg_us = (uint32_t)(periodic->jitter_total_us / stats->releases);
+        }
+        portEXIT_CRITICAL(&periodic->stats_lock);
+
+        xSemaphoreGive(scheduler_mutex);
+        return UFLAKE_OK;
+    }
+
+    xSemaphoreGive(scheduler_mutex);
+    return UFLAKE_ERROR_NOT_FOUND;
+}
+
+#if SCHEDULER_CPU_ACCOUNTING
+static uint32_t cpu_prev_counter(const TaskStatus_t *status)
+{
+    for (uint32_t i = 0; i < cpu_prev_count; i++)
+    {
+        if (cpu_prev[i].handle == status->xHandle && cpu_prev[i].task_number == status->xTaskNumber)
+            return cpu_prev[i].run_counter;
+    }
+    return 0; // Created during the window - all of its run time is new
+}
+
+// Rebuild cpu_snapshot from the counters in cpu_status (scheduler_mutex held)
+static void scheduler_build_snapshot(UBaseType_t count, uint32_t window_us)
+{
+    cpu_snapshot.window_us = window_us;
+    cpu_snapshot.task_count = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        cpu_snapshot.core_load_permille[core] = 1000;
+    }
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        TaskStatus_t *status = &cpu_status[i];
+        uint32_t used_us = (uint32_t)status->ulRunTimeCounter - cpu_prev_counter(status);
+        uint16_t permille = (uint16_t)(((uint64_t)used_us * 1000) / window_us);
+        if (permille > 1000)
+            permille = 1000;
+
+        for (int core = 0; core < portNUM_PROCESSORS; core++)
+        {
+            if (status->xHandle == xTaskGetIdleTaskHandleForCore(core))
+                cpu_snapshot.core_load_permille[core] = 1000 - permille;
+        }
+
+        uflake_task_load_t load = {0};
+        strncpy(load.name, status->pcTaskName, sizeof(load.name) - 1);
+        load.core = (status->xCoreID == tskNO_AFFINITY) ? -1 : (int8_t)status->xCoreID;
+        load.priority = (uint8_t)status->uxCurrentPriority;
+        load.cpu_permille = permille;
+        load.window_us = used_us;
+
+        // process_list owns the process; scheduler_mutex keeps it alive here
+        uflake_process_t *process = (uflake_process_t *)pvTaskGetThreadLocalStoragePointer(
+            status->xHandle, UFLAKE_PROCESS_TLS_INDEX);
+        if (process)
+        {
+            process->cpu_time_us += used_us;
+            process->cpu_permille = permille;
+            load.pid = process->pid;
+            load.cpu_time_us = process->cpu_time_us;
+        }
+
+        // Insertion sort, heaviest first
+        uint32_t pos = cpu_snapshot.task_count++;
+        while (pos > 0 && cpu_snapshot.tasks[pos - 1].cpu_permille < permille)
+        {
+            cpu_snapshot.tasks[pos] = cpu_snapshot.tasks[pos - 1];
+            pos--;
+        }
+        cpu_snapshot.tasks[pos] = load;
+    }
+
+    cpu_snapshot_valid = true;
+}
+
+// Sample the run-time counters once per UFLAKE_CPU_SAMPLE_PERIOD_MS (scheduler_mutex held)
+static void scheduler_sample_cpu(void)
+{
+    int64_t now = esp_timer_get_time();
+    if (cpu_last_sample_us != 0 && (now - cpu_last_sample_us) < (int64_t)UFLAKE_CPU_SAMPLE_PERIOD_MS * 1000)
+        return;
+
+    UBaseType_t count = uxTaskGetSystemState(cpu_status, UFLAKE_CPU_MAX_TASKS, NULL);
+    if (count == 0)
+    {
+        ESP_LOGW(TAG, "More than %d tasks - CPU sample skipped", UFLAKE_CPU_MAX_TASKS);
+        return;
+    }
+
+    // The first sample only sets the baseline
+    if (cpu_last_sample_us != 0)
+    {
+        scheduler_build_snapshot(count, (uint32_t)(now - cpu_last_sample_us));
+    }
+    cpu_last_sample_us = now;
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        cpu_prev[i].handle = cpu_status[i].xHandle;
+        cpu_prev[i].task_number = cpu_status[i].xTaskNumber;
+        cpu_prev[i].run_counter = (uint32_t)cpu_status[i].ulRunTimeCounter;
+    }
+    cpu_prev_count = count;
+}
+#endif
+
 void uflake_scheduler_tick(void)
 {
     // Update process statistics with timeout to prevent deadlock
@@ -127,52 +815,100 @@ void uflake_scheduler_tick(void)
         return;
     }
 
+    scheduler_reap_graveyard();
+
+    // Reap pooled processes whose task was deleted behind the kernel's back
+    // (plain vTaskDelete) - their TCB is gone, so only the PCB is left
     uflake_process_t *current = process_list;
     while (current)
     {
-        if (current->state == PROCESS_STATE_RUNNING)
+        uflake_process_t *next = current->next;
+        if (current->pool_slot >= 0 && !process_pool[current->pool_slot].task_alive)
         {
-            current->cpu_time++;
+            ESP_LOGW(TAG, "Reaping process %s (PID: %d) deleted outside the scheduler",
+                     current->name, (int)current->pid);
+            scheduler_unlink_process(current);
         }
-        current = current->next;
+        current = next;
     }
 
+    int64_t now = esp_timer_get_time();
+    if (now - stack_last_sample_us >= (int64_t)UFLAKE_STACK_SAMPLE_PERIOD_MS * 1000)
+    {
+        stack_last_sample_us = now;
+        for (current = process_list; current; current = current->next)
+        {
+            scheduler_sample_stack(current);
+        }
+    }
+
+#if SCHEDULER_CPU_ACCOUNTING
+    scheduler_sample_cpu();
+#endif
+
     xSemaphoreGive(scheduler_mutex);
 }
 
+uflake_result_t uflake_scheduler_get_cpu_snapshot(uflake_cpu_snapshot_t *snapshot)
+{
+    if (!snapshot)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    xSemaphoreTake(scheduler_mutex, portMAX_DELAY);
+
+    if (!cpu_snapshot_valid)
+    {
+        xSemaphoreGive(scheduler_mutex);
+        return UFLAKE_ERROR_NOT_FOUND;
+    }
+
+    *snapshot = cpu_snapshot;
+    xSemaphoreGive(scheduler_mutex);
+    return UFLAKE_OK;
+}
+
 uflake_result_t uflake_process_terminate(uint32_t pid)
 {
     xSemaphoreTake(scheduler_mutex, portMAX_DELAY);
 
     uflake_process_t *current = process_list;
-    uflake_process_t *prev = NULL;
 
     while (current)
     {
         if (current->pid == pid)
         {
             current->state = PROCESS_STATE_TERMINATED;
-            if (current->task_handle)
-            {
-                vTaskDelete(current->task_handle);
-            }
+            TaskHandle_t task = current->task_handle;
+            scheduler_sample_stack(current);
 
-            // Remove from list
-            if (prev)
-            {
-                prev->next = current->next;
-            }
-            else
+            ESP_LOGI(TAG, "Terminated process PID: %d", (int)pid);
+
+            if (!task || task == xTaskGetCurrentTaskHandle())
             {
-                process_list = current->next;
+                // Nothing else runs this process's code - free it now
+                scheduler_unlink_process(current);
+                if (task)
+                {
+                    // Terminating ourselves - do not take the mutex down with us
+                    vTaskSetThreadLocalStoragePointer(NULL, UFLAKE_PROCESS_TLS_INDEX, NULL);
+                    xSemaphoreGive(scheduler_mutex);
+                    vTaskDelete(NULL);
+                }
+                xSemaphoreGive(scheduler_mutex);
+                return UFLAKE_OK;
             }
 
-            uflake_free(current);
+            // The task may be mid-job on the other core until vTaskDelete()
+            // takes effect - bury it first, free once FreeRTOS lets go. A
+            // blocked task is released inside vTaskDelete(), so reap right away.
+            scheduler_bury_process(current);
+            vTaskSetThreadLocalStoragePointer(task, UFLAKE_PROCESS_TLS_INDEX, NULL);
+            vTaskDelete(task);
+            scheduler_reap_graveyard();
+
             xSemaphoreGive(scheduler_mutex);
-            ESP_LOGI(TAG, "Terminated process PID: %d", (int)pid);
             return UFLAKE_OK;
         }
-        prev = current;
         current = current->next;
     }
 
@@ -248,25 +984,66 @@ uflake_result_t uflake_process_resume(uint32_t pid)
     return UFLAKE_ERROR_NOT_FOUND;
 }
 
-uflake_process_t *uflake_process_get_current(void)
+size_t uflake_process_pool_fit(size_t stack_size)
+{
+    // Slots are ordered by stack size and never change after init
+    for (int i = 0; i < PROCESS_POOL_SLOTS; i++)
+    {
+        if (process_pool[i].stack_size >= stack_size)
+            return process_pool[i].stack_size;
+    }
+    return stack_size;
+}
+
+uflake_result_t uflake_process_get_stack_peak(uint32_t pid, uint32_t *peak_bytes)
 {
-    TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
+    if (!peak_bytes)
+        return UFLAKE_ERROR_INVALID_PARAM;
 
     xSemaphoreTake(scheduler_mutex, portMAX_DELAY);
 
-    uflake_process_t *current = process_list;
-    while (current)
+    for (uflake_process_t *current = process_list; current; current = current->next)
     {
-        if (current->task_handle == current_task)
+        if (current->pid == pid)
         {
+            scheduler_sample_stack(current);
+            *peak_bytes = current->stack_peak;
             xSemaphoreGive(scheduler_mutex);
-            return current;
+            return UFLAKE_OK;
         }
-        current = current->next;
     }
 
     xSemaphoreGive(scheduler_mutex);
-    return NULL;
+    return UFLAKE_ERROR_NOT_FOUND;
+}
+
+void uflake_scheduler_print_stack_report(void)
+{
+    xSemaphoreTake(scheduler_mutex, portMAX_DELAY);
+
+    ESP_LOGI(TAG, "=== Process Stack Usage ===");
+    for (uflake_process_t *current = process_list; current; current = current->next)
+    {
+        scheduler_sample_stack(current);
+        ESP_LOGI(TAG, "%-16s PID=%-3d Stack=%-6u Peak=%-6u (%u%%) Headroom=%u %s",
+                 current->name, (int)current->pid,
+                 (unsigned)current->stack_size, (unsigned)current->stack_peak,
+                 current->stack_size ? (unsigned)(current->stack_peak * 100 / current->stack_size) : 0,
+                 (unsigned)(current->stack_size - current->stack_peak),
+                 (current->pool_slot >= 0) ? "pooled" : "heap");
+    }
+
+    xSemaphoreGive(scheduler_mutex);
+}
+
+uflake_process_t *uflake_process_get_current(void)
+{
+    // ISRs do not belong to a process
+    if (uflake_kernel_is_in_isr())
+        return NULL;
+
+    // Set by process_wrapper; NULL for kernel and other non-process tasks
+    return (uflake_process_t *)pvTaskGetThreadLocalStoragePointer(NULL, UFLAKE_PROCESS_TLS_INDEX);
 }
 
 void uflake_process_yield(uint32_t delay_ms)
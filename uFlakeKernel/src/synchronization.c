@@ -1,16 +1,146 @@
 #include "synchronization.h"
 #include "memory_manager.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include <stdio.h>
+#include <stdlib.h>
 
 static const char *TAG = "SYNC";
 
+// Kernel trace label and async-slice id of a mutex
+#if UFLAKE_MUTEX_PROFILING
+#define MUTEX_TRACE_LABEL(mutex) ((mutex)->name)
+#else
+#define MUTEX_TRACE_LABEL(mutex) "mutex"
+#endif
+#define MUTEX_TRACE_ID(mutex) ((uint32_t)(uintptr_t)(mutex))
+
+#if UFLAKE_MUTEX_PROFILING
+// Registry of every uflake_mutex_t and uflake_rwlock_t, for the contention report
+static uflake_mutex_t *mutex_registry = NULL;
+static uint32_t mutex_registry_count = 0;
+static uflake_rwlock_t *rwlock_registry = NULL;
+static uint32_t rwlock_registry_count = 0;
+static SemaphoreHandle_t registry_mutex = NULL;
+
+static uint32_t mutex_hist_bucket(uint32_t us)
+{
+    uint32_t bucket = 0;
+    for (uint32_t limit = 10; bucket < UFLAKE_MUTEX_HIST_BUCKETS - 1 && us >= limit; limit *= 10)
+    {
+        bucket++;
+    }
+    return bucket;
+}
+
+// Account an acquisition - the caller owns stats (holds the lock that guards them)
+static void sync_stats_acquired(uflake_mutex_stats_t *stats, bool contended, uint32_t wait_us)
+{
+    stats->acquisitions++;
+    if (contended)
+    {
+        stats->contended++;
+        stats->total_wait_us += wait_us;
+        stats->wait_histogram[mutex_hist_bucket(wait_us)]++;
+        if (wait_us > stats->max_wait_us)
+            stats->max_wait_us = wait_us;
+    }
+}
+
+static void sync_stats_released(uflake_mutex_stats_t *stats, uint32_t hold_us, uint32_t pid)
+{
+    stats->total_hold_us += hold_us;
+    stats->hold_histogram[mutex_hist_bucket(hold_us)]++;
+    if (hold_us > stats->max_hold_us)
+    {
+        stats->max_hold_us = hold_us;
+        stats->max_hold_pid = pid;
+    }
+}
+
+static void mutex_registry_add(uflake_mutex_t *mutex)
+{
+    if (!registry_mutex)
+        return;
+
+    xSemaphoreTake(registry_mutex, portMAX_DELAY);
+    mutex->next = mutex_registry;
+    mutex_registry = mutex;
+    mutex_registry_count++;
+    xSemaphoreGive(registry_mutex);
+}
+
+static void mutex_registry_remove(uflake_mutex_t *mutex)
+{
+    if (!registry_mutex)
+        return;
+
+    xSemaphoreTake(registry_mutex, portMAX_DELAY);
+    for (uflake_mutex_t **link = &mutex_registry; *link; link = &(*link)->next)
+    {
+        if (*link == mutex)
+        {
+            *link = mutex->next;
+            mutex_registry_count--;
+            break;
+        }
+    }
+    xSemaphoreGive(registry_mutex);
+}
+
+static void rwlock_registry_add(uflake_rwlock_t *rwlock)
+{
+    if (!registry_mutex)
+        return;
+
+    xSemaphoreTake(registry_mutex, portMAX_DELAY);
+    rwlock->next = rwlock_registry;
+    rwlock_registry = rwlock;
+    rwlock_registry_count++;
+    xSemaphoreGive(registry_mutex);
+}
+
+static void rwlock_registry_remove(uflake_rwlock_t *rwlock)
+{
+    if (!registry_mutex)
+        return;
+
+    xSemaphoreTake(registry_mutex, portMAX_DELAY);
+    for (uflake_rwlock_t **link = &rwlock_registry; *link; link = &(*link)->next)
+    {
+        if (*link == rwlock)
+        {
+            *link = rwlock->next;
+            rwlock_registry_count--;
+            break;
+        }
+    }
+    xSemaphoreGive(registry_mutex);
+}
+#endif
+
 uflake_result_t uflake_sync_init(void)
 {
+#if UFLAKE_MUTEX_PROFILING
+    registry_mutex = xSemaphoreCreateMutex();
+    if (!registry_mutex)
+    {
+        ESP_LOGE(TAG, "Failed to create mutex registry lock");
+        return UFLAKE_ERROR_MEMORY;
+    }
+#endif
+
     ESP_LOGI(TAG, "Synchronization subsystem initialized");
     return UFLAKE_OK;
 }
 
 uflake_result_t uflake_mutex_create(uflake_mutex_t **mutex)
+{
+    return uflake_mutex_create_named(mutex, NULL);
+}
+
+uflake_result_t uflake_mutex_create_named(uflake_mutex_t **mutex, const char *name)
 {
     if (!mutex)
         return UFLAKE_ERROR_INVALID_PARAM;
@@ -31,6 +161,16 @@ uflake_result_t uflake_mutex_create(uflake_mutex_t **mutex)
     new_mutex->owner_pid = 0;
     new_mutex->lock_count = 0;
 
+#if UFLAKE_MUTEX_PROFILING
+    if (name)
+        snprintf(new_mutex->name, sizeof(new_mutex->name), "%s", name);
+    else
+        snprintf(new_mutex->name, sizeof(new_mutex->name), "%p", (void *)new_mutex);
+    new_mutex->locked_at_us = 0;
+    memset(&new_mutex->stats, 0, sizeof(new_mutex->stats));
+    mutex_registry_add(new_mutex);
+#endif
+
     *mutex = new_mutex;
     return UFLAKE_OK;
 }
@@ -50,24 +190,59 @@ uflake_result_t uflake_mutex_lock(uflake_mutex_t *mutex, uint32_t timeout_ms)
     TickType_t timeout_ticks = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
 
     //  Store lock attempt time for deadlock detection
-    uint32_t lock_start = xTaskGetTickCount();
+    int64_t lock_start_us = esp_timer_get_time();
+
+    // Try without blocking first, so uncontended acquisitions can be told apart
+    bool contended = false;
+    BaseType_t taken = xSemaphoreTake(mutex->handle, 0);
+    if (taken != pdTRUE && timeout_ticks > 0)
+    {
+        contended = true;
+        uflake_kernel_trace_record(KERNEL_TRACE_MUTEX_WAIT, MUTEX_TRACE_LABEL(mutex), MUTEX_TRACE_ID(mutex));
+        taken = xSemaphoreTake(mutex->handle, timeout_ticks);
+    }
 
-    if (xSemaphoreTake(mutex->handle, timeout_ticks) == pdTRUE)
+    if (taken == pdTRUE)
     {
+        uflake_kernel_trace_record(KERNEL_TRACE_MUTEX_ACQUIRE, MUTEX_TRACE_LABEL(mutex), MUTEX_TRACE_ID(mutex));
+
+        int64_t now_us = esp_timer_get_time();
+        uint32_t wait_us = (uint32_t)(now_us - lock_start_us);
+
         mutex->lock_count++;
         mutex->owner_pid = uflake_process_get_current() ? uflake_process_get_current()->pid : 0;
 
+#if UFLAKE_MUTEX_PROFILING
+        // We hold the mutex, so its stats are ours to update
+        mutex->locked_at_us = now_us;
+        sync_stats_acquired(&mutex->stats, contended, wait_us);
+#endif
+
         //  Warn if lock took too long
-        uint32_t lock_duration = xTaskGetTickCount() - lock_start;
-        if (lock_duration > pdMS_TO_TICKS(100))
+        if (wait_us > 100 * 1000)
         {
-            ESP_LOGW(TAG, "Mutex lock took %d ms - possible contention", (int)(lock_duration * portTICK_PERIOD_MS));
+#if UFLAKE_MUTEX_PROFILING
+            ESP_LOGW(TAG, "Mutex %s lock took %d ms - possible contention", mutex->name, (int)(wait_us / 1000));
+#else
+            ESP_LOGW(TAG, "Mutex lock took %d ms - possible contention", (int)(wait_us / 1000));
+#endif
         }
 
         return UFLAKE_OK;
     }
 
+    if (contended)
+    {
+        // Close the wait slice
+        uflake_kernel_trace_record(KERNEL_TRACE_MUTEX_RELEASE, MUTEX_TRACE_LABEL(mutex), MUTEX_TRACE_ID(mutex));
+    }
+
+#if UFLAKE_MUTEX_PROFILING
+    __atomic_fetch_add(&mutex->stats.timeouts, 1, __ATOMIC_RELAXED);
+    ESP_LOGW(TAG, "Mutex %s lock timeout after %d ms", mutex->name, (int)timeout_ms);
+#else
     ESP_LOGW(TAG, "Mutex lock timeout after %d ms", (int)timeout_ms);
+#endif
     return UFLAKE_ERROR_TIMEOUT;
 }
 
@@ -81,6 +256,18 @@ uflake_result_t uflake_mutex_unlock(uflake_mutex_t *mutex)
         mutex->lock_count--;
     }
 
+#if UFLAKE_MUTEX_PROFILING
+    // Still held here - account the hold time before releasing
+    if (mutex->locked_at_us != 0)
+    {
+        uint32_t hold_us = (uint32_t)(esp_timer_get_time() - mutex->locked_at_us);
+        mutex->locked_at_us = 0;
+        sync_stats_released(&mutex->stats, hold_us, mutex->owner_pid);
+    }
+#endif
+
+    uflake_kernel_trace_record(KERNEL_TRACE_MUTEX_RELEASE, MUTEX_TRACE_LABEL(mutex), MUTEX_TRACE_ID(mutex));
+
     if (xSemaphoreGive(mutex->handle) == pdTRUE)
     {
         return UFLAKE_OK;
@@ -94,6 +281,10 @@ uflake_result_t uflake_mutex_destroy(uflake_mutex_t *mutex)
     if (!mutex)
         return UFLAKE_ERROR_INVALID_PARAM;
 
+#if UFLAKE_MUTEX_PROFILING
+    mutex_registry_remove(mutex);
+#endif
+
     if (mutex->handle)
     {
         vSemaphoreDelete(mutex->handle);
@@ -103,6 +294,366 @@ uflake_result_t uflake_mutex_destroy(uflake_mutex_t *mutex)
     return UFLAKE_OK;
 }
 
+uflake_result_t uflake_mutex_get_stats(uflake_mutex_t *mutex, uflake_mutex_stats_t *stats)
+{
+    if (!mutex || !stats)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+#if UFLAKE_MUTEX_PROFILING
+    *stats = mutex->stats;
+    return UFLAKE_OK;
+#else
+    return UFLAKE_ERROR;
+#endif
+}
+
+void uflake_mutex_reset_stats(void)
+{
+#if UFLAKE_MUTEX_PROFILING
+    if (!registry_mutex)
+        return;
+
+    xSemaphoreTake(registry_mutex, portMAX_DELAY);
+    for (uflake_mutex_t *mutex = mutex_registry; mutex; mutex = mutex->next)
+    {
+        memset(&mutex->stats, 0, sizeof(mutex->stats));
+    }
+    for (uflake_rwlock_t *rwlock = rwlock_registry; rwlock; rwlock = rwlock->next)
+    {
+        memset(&rwlock->read_stats, 0, sizeof(rwlock->read_stats));
+        memset(&rwlock->write_stats, 0, sizeof(rwlock->write_stats));
+    }
+    xSemaphoreGive(registry_mutex);
+#endif
+}
+
+#if UFLAKE_MUTEX_PROFILING
+typedef struct
+{
+    char name[UFLAKE_MUTEX_NAME_LEN + 2]; // rwlock sides get a ":r" / ":w" suffix
+    uflake_mutex_stats_t stats;
+} mutex_report_row_t;
+
+static int mutex_report_compare(const void *a, const void *b)
+{
+    uint64_t wait_a = ((const mutex_report_row_t *)a)->stats.total_wait_us;
+    uint64_t wait_b = ((const mutex_report_row_t *)b)->stats.total_wait_us;
+    return (wait_a < wait_b) - (wait_a > wait_b);
+}
+#endif
+
+void uflake_mutex_print_contention(void)
+{
+#if UFLAKE_MUTEX_PROFILING
+    if (!registry_mutex)
+        return;
+
+    // Snapshot under the registry lock, sort and log without it
+    xSemaphoreTake(registry_mutex, portMAX_DELAY);
+    uint32_t count = mutex_registry_count + 2 * rwlock_registry_count;
+    if (count == 0)
+    {
+        xSemaphoreGive(registry_mutex);
+        return;
+    }
+
+    mutex_report_row_t *rows = (mutex_report_row_t *)uflake_malloc(count * sizeof(mutex_report_row_t), UFLAKE_MEM_INTERNAL);
+    if (!rows)
+    {
+        xSemaphoreGive(registry_mutex);
+        ESP_LOGE(TAG, "No memory for the contention report");
+        return;
+    }
+
+    uint32_t index = 0;
+    for (uflake_mutex_t *mutex = mutex_registry; mutex && index < count; mutex = mutex->next, index++)
+    {
+        snprintf(rows[index].name, sizeof(rows[index].name), "%s", mutex->name);
+        rows[index].stats = mutex->stats;
+    }
+    for (uflake_rwlock_t *rwlock = rwlock_registry; rwlock && index + 1 < count; rwlock = rwlock->next)
+    {
+        snprintf(rows[index].name, sizeof(rows[index].name), "%.*s:r", UFLAKE_MUTEX_NAME_LEN - 1, rwlock->name);
+        rows[index++].stats = rwlock->read_stats;
+        snprintf(rows[index].name, sizeof(rows[index].name), "%.*s:w", UFLAKE_MUTEX_NAME_LEN - 1, rwlock->name);
+        rows[index++].stats = rwlock->write_stats;
+    }
+    xSemaphoreGive(registry_mutex);
+
+    qsort(rows, index, sizeof(mutex_report_row_t), mutex_report_compare);
+
+    ESP_LOGI(TAG, "=== Lock Contention (%u locks, by total wait) ===", (unsigned)index);
+    for (uint32_t i = 0; i < index; i++)
+    {
+        const uflake_mutex_stats_t *s = &rows[i].stats;
+        if (s->acquisitions == 0 && s->timeouts == 0)
+            continue;
+
+        ESP_LOGI(TAG, "%-18s acq=%u contended=%u (%u%%) timeouts=%u wait total=%llu us max=%u us | hold total=%llu us max=%u us (PID %u)",
+                 rows[i].name, (unsigned)s->acquisitions, (unsigned)s->contended,
+                 s->acquisitions ? (unsigned)(s->contended * 100 / s->acquisitions) : 0,
+                 (unsigned)s->timeouts, (unsigned long long)s->total_wait_us, (unsigned)s->max_wait_us,
+                 (unsigned long long)s->total_hold_us, (unsigned)s->max_hold_us, (unsigned)s->max_hold_pid);
+        ESP_LOGI(TAG, "%-18s wait hist %u/%u/%u/%u/%u/%u  hold hist %u/%u/%u/%u/%u/%u (<10us..>=100ms)", "",
+                 (unsigned)s->wait_histogram[0], (unsigned)s->wait_histogram[1], (unsigned)s->wait_histogram[2],
+                 (unsigned)s->wait_histogram[3], (unsigned)s->wait_histogram[4], (unsigned)s->wait_histogram[5],
+                 (unsigned)s->hold_histogram[0], (unsigned)s->hold_histogram[1], (unsigned)s->hold_histogram[2],
+                 (unsigned)s->hold_histogram[3], (unsigned)s->hold_histogram[4], (unsigned)s->hold_histogram[5]);
+    }
+
+    uflake_free(rows);
+#endif
+}
+
+// Ticks left of a timeout that started at start_ticks (portMAX_DELAY stays infinite)
+static TickType_t sync_ticks_left(TickType_t start_ticks, TickType_t timeout_ticks)
+{
+    if (timeout_ticks == portMAX_DELAY)
+        return portMAX_DELAY;
+
+    TickType_t elapsed = xTaskGetTickCount() - start_ticks;
+    return (elapsed >= timeout_ticks) ? 0 : timeout_ticks - elapsed;
+}
+
+uflake_result_t uflake_rwlock_create(uflake_rwlock_t **rwlock)
+{
+    return uflake_rwlock_create_named(rwlock, NULL);
+}
+
+uflake_result_t uflake_rwlock_create_named(uflake_rwlock_t **rwlock, const char *name)
+{
+    if (!rwlock)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    uflake_rwlock_t *new_lock = (uflake_rwlock_t *)uflake_calloc(1, sizeof(uflake_rwlock_t), UFLAKE_MEM_INTERNAL);
+    if (!new_lock)
+    {
+        return UFLAKE_ERROR_MEMORY;
+    }
+
+    new_lock->turnstile = xSemaphoreCreateMutex();
+    new_lock->reader_mutex = xSemaphoreCreateMutex();
+    new_lock->room_empty = xSemaphoreCreateBinary();
+    if (!new_lock->turnstile || !new_lock->reader_mutex || !new_lock->room_empty)
+    {
+        uflake_rwlock_destroy(new_lock);
+        return UFLAKE_ERROR_MEMORY;
+    }
+
+    xSemaphoreGive(new_lock->room_empty);
+    new_lock->readers = 0;
+
+#if UFLAKE_MUTEX_PROFILING
+    if (name)
+        snprintf(new_lock->name, sizeof(new_lock->name), "%s", name);
+    else
+        snprintf(new_lock->name, sizeof(new_lock->name), "%p", (void *)new_lock);
+    rwlock_registry_add(new_lock);
+#endif
+
+    *rwlock = new_lock;
+    return UFLAKE_OK;
+}
+
+// Take sem, first without blocking so a wait can be told apart; sets *contended if it had to wait
+static bool rwlock_take(SemaphoreHandle_t sem, TickType_t ticks, bool *contended)
+{
+    if (xSemaphoreTake(sem, 0) == pdTRUE)
+        return true;
+
+    *contended = true;
+    return ticks > 0 && xSemaphoreTake(sem, ticks) == pdTRUE;
+}
+
+static uflake_result_t rwlock_timed_out(uflake_rwlock_t *rwlock, uflake_mutex_stats_t *stats, const char *side)
+{
+#if UFLAKE_MUTEX_PROFILING
+    __atomic_fetch_add(&stats->timeouts, 1, __ATOMIC_RELAXED);
+    ESP_LOGW(TAG, "Rwlock %s %s lock timed out", rwlock->name, side);
+#endif
+    return UFLAKE_ERROR_TIMEOUT;
+}
+
+uflake_result_t uflake_rwlock_read_lock(uflake_rwlock_t *rwlock, uint32_t timeout_ms)
+{
+    if (!rwlock)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    if (uflake_kernel_is_in_isr())
+    {
+        ESP_LOGE(TAG, "FATAL: Attempted to take rwlock from ISR!");
+        return UFLAKE_ERROR;
+    }
+
+    TickType_t timeout_ticks = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    TickType_t start_ticks = xTaskGetTickCount();
+    int64_t start_us = esp_timer_get_time();
+    bool contended = false;
+
+    // Pass through the turnstile - blocks while a writer is waiting or inside
+    if (!rwlock_take(rwlock->turnstile, timeout_ticks, &contended))
+        return rwlock_timed_out(rwlock, &rwlock->read_stats, "read");
+    xSemaphoreGive(rwlock->turnstile);
+
+    if (xSemaphoreTake(rwlock->reader_mutex, sync_ticks_left(start_ticks, timeout_ticks)) != pdTRUE)
+        return rwlock_timed_out(rwlock, &rwlock->read_stats, "read");
+
+    // First reader in locks writers out of the room
+    if (rwlock->readers == 0 &&
+        !rwlock_take(rwlock->room_empty, sync_ticks_left(start_ticks, timeout_ticks), &contended))
+    {
+        xSemaphoreGive(rwlock->reader_mutex);
+        return rwlock_timed_out(rwlock, &rwlock->read_stats, "read");
+    }
+    rwlock->readers++;
+
+#if UFLAKE_MUTEX_PROFILING
+    // reader_mutex guards the read side stats
+    sync_stats_acquired(&rwlock->read_stats, contended, (uint32_t)(esp_timer_get_time() - start_us));
+#else
+    (void)start_us;
+#endif
+
+    xSemaphoreGive(rwlock->reader_mutex);
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_rwlock_read_unlock(uflake_rwlock_t *rwlock)
+{
+    if (!rwlock)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    xSemaphoreTake(rwlock->reader_mutex, portMAX_DELAY);
+
+    if (rwlock->readers == 0)
+    {
+        xSemaphoreGive(rwlock->reader_mutex);
+        return UFLAKE_ERROR;
+    }
+
+    // Last reader out lets writers in
+    if (--rwlock->readers == 0)
+    {
+        xSemaphoreGive(rwlock->room_empty);
+    }
+
+    xSemaphoreGive(rwlock->reader_mutex);
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_rwlock_write_lock(uflake_rwlock_t *rwlock, uint32_t timeout_ms)
+{
+    if (!rwlock)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    if (uflake_kernel_is_in_isr())
+    {
+        ESP_LOGE(TAG, "FATAL: Attempted to take rwlock from ISR!");
+        return UFLAKE_ERROR;
+    }
+
+    TickType_t timeout_ticks = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    TickType_t start_ticks = xTaskGetTickCount();
+    int64_t start_us = esp_timer_get_time();
+    bool contended = false;
+
+    // Close the turnstile first so no new reader gets in, then wait for the room to drain
+    if (!rwlock_take(rwlock->turnstile, timeout_ticks, &contended))
+        return rwlock_timed_out(rwlock, &rwlock->write_stats, "write");
+
+    if (!rwlock_take(rwlock->room_empty, sync_ticks_left(start_ticks, timeout_ticks), &contended))
+    {
+        xSemaphoreGive(rwlock->turnstile);
+        return rwlock_timed_out(rwlock, &rwlock->write_stats, "write");
+    }
+
+#if UFLAKE_MUTEX_PROFILING
+    // Exclusive now - the write side stats are ours
+    int64_t now_us = esp_timer_get_time();
+    rwlock->write_locked_at_us = now_us;
+    sync_stats_acquired(&rwlock->write_stats, contended, (uint32_t)(now_us - start_us));
+#else
+    (void)start_us;
+#endif
+
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_rwlock_write_unlock(uflake_rwlock_t *rwlock)
+{
+    if (!rwlock)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+#if UFLAKE_MUTEX_PROFILING
+    if (rwlock->write_locked_at_us != 0)
+    {
+        uflake_process_t *current = uflake_process_get_current();
+        sync_stats_released(&rwlock->write_stats, (uint32_t)(esp_timer_get_time() - rwlock->write_locked_at_us),
+                            current ? current->pid : 0);
+        rwlock->write_locked_at_us = 0;
+    }
+#endif
+
+    xSemaphoreGive(rwlock->room_empty);
+
+    if (xSemaphoreGive(rwlock->turnstile) != pdTRUE)
+        return UFLAKE_ERROR;
+
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_rwlock_destroy(uflake_rwlock_t *rwlock)
+{
+    if (!rwlock)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+#if UFLAKE_MUTEX_PROFILING
+    rwlock_registry_remove(rwlock);
+#endif
+
+    if (rwlock->turnstile)
+        vSemaphoreDelete(rwlock->turnstile);
+    if (rwlock->reader_mutex)
+        vSemaphoreDelete(rwlock->reader_mutex);
+    if (rwlock->room_empty)
+        vSemaphoreDelete(rwlock->room_empty);
+
+    uflake_free(rwlock);
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_rwlock_get_stats(uflake_rwlock_t *rwlock, uflake_mutex_stats_t *read_stats,
+                                        uflake_mutex_stats_t *write_stats)
+{
+    if (!rwlock)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+#if UFLAKE_MUTEX_PROFILING
+    if (read_stats)
+        *read_stats = rwlock->read_stats;
+    if (write_stats)
+        *write_stats = rwlock->write_stats;
+    return UFLAKE_OK;
+#else
+    return UFLAKE_ERROR;
+#endif
+}
+
+void uflake_spinlock_init(uflake_spinlock_t *lock)
+{
+    portMUX_INITIALIZE(&lock->mux);
+}
+
+void IRAM_ATTR uflake_spinlock_lock(uflake_spinlock_t *lock)
+{
+    portENTER_CRITICAL_SAFE(&lock->mux);
+}
+
+void IRAM_ATTR uflake_spinlock_unlock(uflake_spinlock_t *lock)
+{
+    portEXIT_CRITICAL_SAFE(&lock->mux);
+}
+
 uflake_result_t uflake_semaphore_create(uflake_semaphore_t **semaphore, uint32_t initial_count, uint32_t max_count)
 {
     if (!semaphore || max_count == 0)
@@ -279,3 +830,133 @@ uflake_result_t uflake_mutex_give_handle(SemaphoreHandle_t handle)
 
     return UFLAKE_ERROR;
 }
+
+// ============================================================================
+// MICROBENCHMARK
+// ============================================================================
+
+typedef enum
+{
+    SYNC_BENCH_MUTEX,
+    SYNC_BENCH_RWLOCK_READ,
+    SYNC_BENCH_RWLOCK_WRITE,
+    SYNC_BENCH_SPINLOCK,
+    SYNC_BENCH_COUNT
+} sync_bench_kind_t;
+
+typedef struct
+{
+    sync_bench_kind_t kind;
+    uflake_mutex_t *mutex;
+    uflake_rwlock_t *rwlock;
+    uflake_spinlock_t spinlock;
+    uint32_t iterations;
+    volatile uint32_t shared; // Touched inside every critical section
+    SemaphoreHandle_t helper_done;
+} sync_bench_t;
+
+static void sync_bench_loop(sync_bench_t *bench)
+{
+    for (uint32_t i = 0; i < bench->iterations; i++)
+    {
+        switch (bench->kind)
+        {
+        case SYNC_BENCH_MUTEX:
+            uflake_mutex_lock(bench->mutex, UINT32_MAX);
+            bench->shared++;
+            uflake_mutex_unlock(bench->mutex);
+            break;
+        case SYNC_BENCH_RWLOCK_READ:
+            uflake_rwlock_read_lock(bench->rwlock, UINT32_MAX);
+            (void)bench->shared;
+            uflake_rwlock_read_unlock(bench->rwlock);
+            break;
+        case SYNC_BENCH_RWLOCK_WRITE:
+            uflake_rwlock_write_lock(bench->rwlock, UINT32_MAX);
+            bench->shared++;
+            uflake_rwlock_write_unlock(bench->rwlock);
+            break;
+        default:
+            uflake_spinlock_lock(&bench->spinlock);
+            bench->shared++;
+            uflake_spinlock_unlock(&bench->spinlock);
+            break;
+        }
+    }
+}
+
+static void sync_bench_helper(void *args)
+{
+    sync_bench_t *bench = (sync_bench_t *)args;
+    sync_bench_loop(bench);
+    xSemaphoreGive(bench->helper_done);
+    vTaskDelete(NULL);
+}
+
+// ns per lock/unlock pair on the calling task; contended adds a helper on the other core
+static uint32_t sync_bench_run(sync_bench_t *bench, bool contended)
+{
+    TaskHandle_t helper = NULL;
+    int other_core = (xPortGetCoreID() + 1) % portNUM_PROCESSORS;
+
+    if (contended && xTaskCreatePinnedToCore(sync_bench_helper, "uFlake_Bench", 2048, bench,
+                                             uxTaskPriorityGet(NULL), &helper, other_core) != pdPASS)
+    {
+        return 0;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    sync_bench_loop(bench);
+    int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+    if (helper)
+    {
+        xSemaphoreTake(bench->helper_done, portMAX_DELAY);
+    }
+
+    return (uint32_t)(elapsed_us * 1000 / bench->iterations);
+}
+
+void uflake_sync_benchmark(uint32_t iterations)
+{
+    static const char *names[SYNC_BENCH_COUNT] = {"mutex", "rwlock read", "rwlock write", "spinlock"};
+
+    if (iterations == 0)
+        iterations = 10000;
+
+    sync_bench_t *bench = (sync_bench_t *)uflake_calloc(1, sizeof(sync_bench_t), UFLAKE_MEM_INTERNAL);
+    if (!bench)
+        return;
+
+    bench->iterations = iterations;
+    uflake_spinlock_init(&bench->spinlock);
+    bench->helper_done = xSemaphoreCreateBinary();
+
+    if (!bench->helper_done ||
+        uflake_mutex_create_named(&bench->mutex, "sync_bench") != UFLAKE_OK ||
+        uflake_rwlock_create(&bench->rwlock) != UFLAKE_OK)
+    {
+        ESP_LOGE(TAG, "Benchmark setup failed");
+        goto cleanup;
+    }
+
+    ESP_LOGI(TAG, "=== Lock benchmark (%u lock/unlock pairs, core %d) ===",
+             (unsigned)iterations, xPortGetCoreID());
+    for (int kind = 0; kind < SYNC_BENCH_COUNT; kind++)
+    {
+        bench->kind = (sync_bench_kind_t)kind;
+        uint32_t alone_ns = sync_bench_run(bench, false);
+        uint32_t contended_ns = (portNUM_PROCESSORS > 1) ? sync_bench_run(bench, true) : 0;
+        ESP_LOGI(TAG, "%-13s %6u ns uncontended, %6u ns contended across cores",
+                 names[kind], (unsigned)alone_ns, (unsigned)contended_ns);
+    }
+
+cleanup:
+    if (bench->rwlock)
+        uflake_rwlock_destroy(bench->rwlock);
+    if (bench->mutex)
+        uflake_mutex_destroy(bench->mutex);
+    if (bench->helper_done)
+        vSemaphoreDelete(bench->helper_done);
+    uflake_free(bench);
+}
@@ -1,19 +1,346 @@
 #include "timer_manager.h"
 #include "memory_manager.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 static const char *TAG = "TIMER_MGR";
 static uint32_t next_timer_id = 1;
 static SemaphoreHandle_t timer_mutex = NULL;
 
-// Add proper timer structure with next pointer
+// Armed timers live in a binary min-heap ordered by their latest allowed
+// firing time (next_trigger_us + slack_us). The timer service task sleeps
+// until the heap top must fire, woken by a one-shot esp_timer alarm, and then
+// fires every timer whose own deadline has already been reached - so timers
+// with overlapping slack windows share one wakeup. Deadlines have microsecond
+// resolution and do not depend on the kernel loop period. Timer IDs resolve
+// through a hash table.
+#define TIMER_HASH_BUCKETS 64 // Must be a power of two
+#define TIMER_HEAP_INITIAL_CAPACITY 16
+#define TIMER_NOT_ARMED UINT32_MAX
+#define TIMER_WAKEUP_WINDOW_US 1000000
+
 typedef struct timer_node
 {
     uflake_timer_t timer;
-    struct timer_node *next;
+    uint32_t heap_index;          // Position in timer_heap, TIMER_NOT_ARMED if stopped
+    uint32_t arm_generation;      // Bumped by start/stop - cancels dispatches already queued
+    bool free_pending;            // Deleted while its callback runs; freed when it returns
+    struct timer_node *hash_next; // ID lookup chain
 } timer_node_t;
 
-static timer_node_t *timer_list_head = NULL;
+static timer_node_t *timer_hash[TIMER_HASH_BUCKETS] = {0};
+static timer_node_t **timer_heap = NULL;
+static uint32_t heap_count = 0;
+static uint32_t heap_capacity = 0;
+
+static TaskHandle_t timer_service_task = NULL;
+static timer_node_t *timer_running = NULL; // Timer whose callback is running, under timer_mutex
+static esp_timer_handle_t timer_alarm = NULL;
+
+// Expired timer handed from the heap to the daemon queue
+typedef struct
+{
+    uint32_t timer_id;
+    uint32_t arm_generation;
+    timer_callback_t callback;
+    void *args;
+    int64_t deadline_us;
+} timer_dispatch_t;
+
+static QueueHandle_t timer_cb_queue = NULL;
+static uflake_timer_stats_t timer_stats = {0};
+
+// Latest time the timer may fire - the heap key
+static inline int64_t timer_hard_deadline(const timer_node_t *node)
+{
+    return node->timer.next_trigger_us + node->timer.slack_us;
+}
+
+static timer_node_t *timer_lookup(uint32_t timer_id)
+{
+    timer_node_t *node = timer_hash[timer_id & (TIMER_HASH_BUCKETS - 1)];
+    while (node && node->timer.timer_id != timer_id)
+    {
+        node = node->hash_next;
+    }
+    return node;
+}
+
+// ============================================================================
+// MIN-HEAP
+// ============================================================================
+
+static inline void heap_place(timer_node_t *node, uint32_t index)
+{
+    timer_heap[index] = node;
+    node->heap_index = index;
+}
+
+static void heap_sift_up(uint32_t index)
+{
+    timer_node_t *node = timer_heap[index];
+    while (index > 0)
+    {
+        uint32_t parent = (index - 1) / 2;
+        if (timer_hard_deadline(timer_heap[parent]) <= timer_hard_deadline(node))
+            break;
+        heap_place(timer_heap[parent], index);
+        index = parent;
+    }
+    heap_place(node, index);
+}
+
+static void heap_sift_down(uint32_t index)
+{
+    timer_node_t *node = timer_heap[index];
+    while (true)
+    {
+        uint32_t child = 2 * index + 1;
+        if (child >= heap_count)
+            break;
+        if (child + 1 < heap_count &&
+            timer_hard_deadline(timer_heap[child + 1]) < timer_hard_deadline(timer_heap[child]))
+        {
+            child++;
+        }
+        if (timer_hard_deadline(node) <= timer_hard_deadline(timer_heap[child]))
+            break;
+        heap_place(timer_heap[child], index);
+        index = child;
+    }
+    heap_place(node, index);
+}
+
+static bool heap_push(timer_node_t *node)
+{
+    if (heap_count == heap_capacity)
+    {
+        uint32_t new_capacity = heap_capacity ? heap_capacity * 2 : TIMER_HEAP_INITIAL_CAPACITY;
+        timer_node_t **new_heap = (timer_node_t **)uflake_realloc(timer_heap, new_capacity * sizeof(timer_node_t *));
+        if (!new_heap)
+            return false;
+        timer_heap = new_heap;
+        heap_capacity = new_capacity;
+    }
+
+    heap_place(node, heap_count++);
+    heap_sift_up(node->heap_index);
+    node->timer.is_active = true;
+    return true;
+}
+
+static void heap_remove(timer_node_t *node)
+{
+    if (node->heap_index == TIMER_NOT_ARMED)
+        return;
+
+    uint32_t index = node->heap_index;
+    timer_node_t *last = timer_heap[--heap_count];
+
+    if (last != node)
+    {
+        heap_place(last, index);
+        heap_sift_down(index);
+        heap_sift_up(last->heap_index);
+    }
+
+    node->heap_index = TIMER_NOT_ARMED;
+    node->timer.is_active = false;
+}
+
+// ============================================================================
+// TIMER SERVICE
+// ============================================================================
+
+static void timer_alarm_cb(void *arg)
+{
+    if (timer_service_task)
+    {
+        xTaskNotifyGive(timer_service_task);
+    }
+}
+
+// Advance a periodic timer by whole periods from its previous deadline, so
+// callback latency never accumulates as drift
+static void timer_schedule_next_period(timer_node_t *node, int64_t now)
+{
+    int64_t interval = (int64_t)node->timer.interval_us;
+    node->timer.next_trigger_us += interval;
+
+    if (node->timer.next_trigger_us > now)
+        return;
+
+    // Fired at least one whole period late
+    int64_t missed = (now - node->timer.next_trigger_us) / interval + 1;
+
+    switch (node->timer.overrun_policy)
+    {
+    case TIMER_OVERRUN_CATCH_UP:
+        // Leave the deadline in the past - the expire loop fires it again,
+        // once per missed period, so count one late period per pass
+        node->timer.overrun_count++;
+        break;
+    case TIMER_OVERRUN_REPORT:
+        ESP_LOGW(TAG, "Timer %d overrun: missed %d period(s) of %llu us",
+                 (int)node->timer.timer_id, (int)missed, (unsigned long long)node->timer.interval_us);
+        // fall through
+    case TIMER_OVERRUN_SKIP:
+    default:
+        node->timer.overrun_count += (uint32_t)missed;
+        node->timer.next_trigger_us += missed * interval;
+        break;
+    }
+}
+
+// Move due timers onto the daemon queue under timer_mutex. Returns the time
+// the next wakeup must happen by (INT64_MAX if none armed); sets *more_due if
+// the queue filled up before every due timer was collected.
+static int64_t timer_collect_due(bool *more_due)
+{
+    xSemaphoreTake(timer_mutex, portMAX_DELAY);
+
+    int64_t now = esp_timer_get_time();
+    *more_due = false;
+
+    // Walk in hard-deadline order, taking every timer whose window has opened
+    while (heap_count > 0 && timer_heap[0]->timer.next_trigger_us <= now)
+    {
+        timer_node_t *node = timer_heap[0];
+
+        if (timer_hard_deadline(node) > now)
+        {
+            timer_stats.coalesced_timers++;
+        }
+        timer_dispatch_t dispatch = {
+            .timer_id = node->timer.timer_id,
+            .arm_generation = node->arm_generation,
+            .callback = node->timer.callback,
+            .args = node->timer.args,
+            .deadline_us = node->timer.next_trigger_us};
+
+        if (xQueueSend(timer_cb_queue, &dispatch, 0) != pdTRUE)
+        {
+            // Daemon queue full - leave the rest armed for the next pass
+            timer_stats.queue_full_deferrals++;
+            *more_due = true;
+            break;
+        }
+
+        heap_remove(node);
+
+        // Re-arm before the callback runs so it may stop/restart its own timer
+        if (node->timer.is_periodic)
+        {
+            timer_schedule_next_period(node, now);
+            heap_push(node);
+        }
+    }
+
+    int64_t next_deadline = (heap_count > 0) ? timer_hard_deadline(timer_heap[0]) : INT64_MAX;
+
+    xSemaphoreGive(timer_mutex);
+    return next_deadline;
+}
+
+// Run queued callbacks with timer_mutex released
+static void timer_run_deferred(void)
+{
+    timer_dispatch_t dispatch;
+
+    while (xQueueReceive(timer_cb_queue, &dispatch, 0) == pdTRUE)
+    {
+        // Skip timers stopped, restarted or deleted after they were collected,
+        // and pin the rest so delete waits for the callback before args go away
+        xSemaphoreTake(timer_mutex, portMAX_DELAY);
+        timer_node_t *node = timer_lookup(dispatch.timer_id);
+        bool run = node && node->arm_generation == dispatch.arm_generation && dispatch.callback;
+        timer_running = run ? node : NULL;
+        xSemaphoreGive(timer_mutex);
+
+        if (!run)
+            continue;
+
+        int64_t start_us = esp_timer_get_time();
+        uflake_kernel_trace_record(KERNEL_TRACE_TIMER_BEGIN, "timer", dispatch.timer_id);
+        dispatch.callback(dispatch.args);
+        uflake_kernel_trace_record(KERNEL_TRACE_TIMER_END, "timer", dispatch.timer_id);
+        uint32_t runtime_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+        xSemaphoreTake(timer_mutex, portMAX_DELAY);
+        timer_running = NULL;
+        if (node->free_pending)
+        {
+            uflake_free(node);
+        }
+        xSemaphoreGive(timer_mutex);
+
+        // Only this task writes the stats
+        timer_stats.callbacks_run++;
+        timer_stats.total_runtime_us += runtime_us;
+        if (start_us - dispatch.deadline_us > timer_stats.max_latency_us)
+        {
+            timer_stats.max_latency_us = (uint32_t)(start_us - dispatch.deadline_us);
+        }
+        if (runtime_us > timer_stats.max_runtime_us)
+        {
+            timer_stats.max_runtime_us = runtime_us;
+            timer_stats.max_runtime_timer_id = dispatch.timer_id;
+        }
+        if (runtime_us > UFLAKE_TIMER_CALLBACK_BUDGET_US)
+        {
+            timer_stats.budget_overruns++;
+            ESP_LOGD(TAG, "Timer %d callback took %u us (budget %u us)",
+                     (int)dispatch.timer_id, (unsigned)runtime_us, (unsigned)UFLAKE_TIMER_CALLBACK_BUDGET_US);
+        }
+    }
+}
+
+static void timer_count_wakeup(void)
+{
+    static int64_t window_start_us = 0;
+    static uint32_t window_wakeups = 0;
+
+    int64_t now = esp_timer_get_time();
+    timer_stats.wakeups++;
+    window_wakeups++;
+
+    if (now - window_start_us >= TIMER_WAKEUP_WINDOW_US)
+    {
+        timer_stats.wakeups_per_sec = (uint32_t)(((int64_t)window_wakeups * 1000000) / (now - window_start_us));
+        window_start_us = now;
+        window_wakeups = 0;
+    }
+}
+
+static void timer_service_task_fn(void *args)
+{
+    ESP_LOGI(TAG, "Timer service running");
+
+    while (true)
+    {
+        bool more_due;
+        int64_t next_deadline;
+
+        timer_count_wakeup();
+
+        do
+        {
+            next_deadline = timer_collect_due(&more_due);
+            timer_run_deferred();
+        } while (more_due);
+
+        // Re-arm the one-shot alarm for the earliest deadline
+        esp_timer_stop(timer_alarm);
+        if (next_deadline != INT64_MAX)
+        {
+            int64_t delay_us = next_deadline - esp_timer_get_time();
+            esp_timer_start_once(timer_alarm, (delay_us > 0) ? (uint64_t)delay_us : 1);
+        }
+
+        // Alarm or a start() that moved the earliest deadline wakes us
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
 
 uflake_result_t uflake_timer_init(void)
 {
@@ -24,14 +351,41 @@ uflake_result_t uflake_timer_init(void)
         return UFLAKE_ERROR_MEMORY;
     }
 
+    timer_cb_queue = xQueueCreate(UFLAKE_TIMER_CALLBACK_QUEUE_LEN, sizeof(timer_dispatch_t));
+    if (!timer_cb_queue)
+    {
+        ESP_LOGE(TAG, "Failed to create timer callback queue");
+        return UFLAKE_ERROR_MEMORY;
+    }
+
+    const esp_timer_create_args_t alarm_args = {
+        .callback = timer_alarm_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "uflake_timer",
+        .skip_unhandled_events = true};
+
+    if (esp_timer_create(&alarm_args, &timer_alarm) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to create timer alarm");
+        return UFLAKE_ERROR;
+    }
+
+    if (xTaskCreate(timer_service_task_fn, "uFlake_Timer", UFLAKE_TIMER_SERVICE_STACK_SIZE,
+                    NULL, UFLAKE_TIMER_SERVICE_PRIORITY, &timer_service_task) != pdPASS)
+    {
+        ESP_LOGE(TAG, "Failed to create timer service task");
+        return UFLAKE_ERROR_MEMORY;
+    }
+
     ESP_LOGI(TAG, "Timer manager initialized");
     return UFLAKE_OK;
 }
 
-uflake_result_t uflake_timer_create(uint32_t *timer_id, uint32_t interval_ms,
-                                    timer_callback_t callback, void *args, bool periodic)
+uflake_result_t uflake_timer_create_ex(uint32_t *timer_id, uint64_t interval_us, uint32_t slack_us,
+                                       timer_callback_t callback, void *args, bool periodic)
 {
-    if (!timer_id || !callback || interval_ms == 0)
+    if (!timer_id || !callback || interval_us == 0)
         return UFLAKE_ERROR_INVALID_PARAM;
 
     xSemaphoreTake(timer_mutex, portMAX_DELAY);
@@ -44,133 +398,208 @@ uflake_result_t uflake_timer_create(uint32_t *timer_id, uint32_t interval_ms,
     }
 
     node->timer.timer_id = next_timer_id++;
-    node->timer.interval_ms = interval_ms;
-    node->timer.next_trigger = xTaskGetTickCount() + pdMS_TO_TICKS(interval_ms);
+    node->timer.interval_us = interval_us;
+    node->timer.next_trigger_us = 0;
+    node->timer.slack_us = slack_us;
     node->timer.callback = callback;
     node->timer.args = args;
+    node->timer.overrun_policy = TIMER_OVERRUN_SKIP;
+    node->timer.overrun_count = 0;
     node->timer.is_periodic = periodic;
     node->timer.is_active = false;
-    node->next = timer_list_head;
-    timer_list_head = node;
+    node->heap_index = TIMER_NOT_ARMED;
+    node->arm_generation = 0;
+    node->free_pending = false;
+
+    timer_node_t **bucket = &timer_hash[node->timer.timer_id & (TIMER_HASH_BUCKETS - 1)];
+    node->hash_next = *bucket;
+    *bucket = node;
 
     *timer_id = node->timer.timer_id;
 
     xSemaphoreGive(timer_mutex);
-    ESP_LOGD(TAG, "Created timer ID: %d, interval: %d ms", (int)*timer_id, (int)interval_ms);
+    ESP_LOGD(TAG, "Created timer ID: %d, interval: %llu us, slack: %u us",
+             (int)*timer_id, (unsigned long long)interval_us, (unsigned)slack_us);
 
     return UFLAKE_OK;
 }
 
+uflake_result_t uflake_timer_create_us(uint32_t *timer_id, uint64_t interval_us,
+                                       timer_callback_t callback, void *args, bool periodic)
+{
+    return uflake_timer_create_ex(timer_id, interval_us, 0, callback, args, periodic);
+}
+
+uflake_result_t uflake_timer_create(uint32_t *timer_id, uint32_t interval_ms,
+                                    timer_callback_t callback, void *args, bool periodic)
+{
+    if (interval_ms == 0)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    return uflake_timer_create_us(timer_id, (uint64_t)interval_ms * 1000, callback, args, periodic);
+}
+
 uflake_result_t uflake_timer_start(uint32_t timer_id)
 {
     xSemaphoreTake(timer_mutex, portMAX_DELAY);
 
-    timer_node_t *node = timer_list_head;
-    while (node)
+    timer_node_t *node = timer_lookup(timer_id);
+    if (!node)
     {
-        if (node->timer.timer_id == timer_id)
-        {
-            node->timer.is_active = true;
-            node->timer.next_trigger = xTaskGetTickCount() + pdMS_TO_TICKS(node->timer.interval_ms);
-            xSemaphoreGive(timer_mutex);
-            ESP_LOGD(TAG, "Started timer ID: %d", (int)timer_id);
-            return UFLAKE_OK;
-        }
-        node = node->next;
+        xSemaphoreGive(timer_mutex);
+        return UFLAKE_ERROR_NOT_FOUND;
+    }
+
+    // Restart re-arms from now - this also sets the periodic phase
+    heap_remove(node);
+    node->arm_generation++;
+    node->timer.next_trigger_us = esp_timer_get_time() + (int64_t)node->timer.interval_us;
+
+    if (!heap_push(node))
+    {
+        xSemaphoreGive(timer_mutex);
+        return UFLAKE_ERROR_MEMORY;
     }
 
+    bool is_earliest = (node->heap_index == 0);
     xSemaphoreGive(timer_mutex);
-    return UFLAKE_ERROR_NOT_FOUND;
+
+    // New earliest deadline - service task must re-arm its alarm
+    if (is_earliest && timer_service_task)
+    {
+        xTaskNotifyGive(timer_service_task);
+    }
+
+    ESP_LOGD(TAG, "Started timer ID: %d", (int)timer_id);
+    return UFLAKE_OK;
 }
 
 uflake_result_t uflake_timer_stop(uint32_t timer_id)
 {
     xSemaphoreTake(timer_mutex, portMAX_DELAY);
 
-    timer_node_t *node = timer_list_head;
-    while (node)
+    timer_node_t *node = timer_lookup(timer_id);
+    if (!node)
     {
-        if (node->timer.timer_id == timer_id)
-        {
-            node->timer.is_active = false;
-            xSemaphoreGive(timer_mutex);
-            ESP_LOGD(TAG, "Stopped timer ID: %d", (int)timer_id);
-            return UFLAKE_OK;
-        }
-        node = node->next;
+        xSemaphoreGive(timer_mutex);
+        return UFLAKE_ERROR_NOT_FOUND;
     }
 
+    // A stale alarm for this timer just wakes the service once for nothing
+    heap_remove(node);
+    node->arm_generation++;
+
     xSemaphoreGive(timer_mutex);
-    return UFLAKE_ERROR_NOT_FOUND;
+    ESP_LOGD(TAG, "Stopped timer ID: %d", (int)timer_id);
+    return UFLAKE_OK;
 }
 
 uflake_result_t uflake_timer_delete(uint32_t timer_id)
 {
     xSemaphoreTake(timer_mutex, portMAX_DELAY);
 
-    timer_node_t *prev = NULL;
-    timer_node_t *current = timer_list_head;
+    timer_node_t **link = &timer_hash[timer_id & (TIMER_HASH_BUCKETS - 1)];
+    while (*link && (*link)->timer.timer_id != timer_id)
+    {
+        link = &(*link)->hash_next;
+    }
+
+    timer_node_t *node = *link;
+    if (!node)
+    {
+        xSemaphoreGive(timer_mutex);
+        return UFLAKE_ERROR_NOT_FOUND;
+    }
+
+    // Remove from heap and hash chain
+    heap_remove(node);
+    *link = node->hash_next;
+
+    if (timer_running != node)
+    {
+        uflake_free(node);
+        xSemaphoreGive(timer_mutex);
+        ESP_LOGD(TAG, "Deleted timer ID: %d", (int)timer_id);
+        return UFLAKE_OK;
+    }
+
+    // Callback in flight - the service task frees the node when it returns
+    node->free_pending = true;
+    xSemaphoreGive(timer_mutex);
 
-    while (current)
+    // Unless this is that callback, wait for it so the caller may free args
+    if (xTaskGetCurrentTaskHandle() != timer_service_task)
     {
-        if (current->timer.timer_id == timer_id)
+        bool running = true;
+        while (running)
         {
-            // Remove from linked list
-            if (prev)
-            {
-                prev->next = current->next;
-            }
-            else
-            {
-                timer_list_head = current->next;
-            }
-
-            uflake_free(current);
+            vTaskDelay(1);
+            xSemaphoreTake(timer_mutex, portMAX_DELAY);
+            running = (timer_running == node);
             xSemaphoreGive(timer_mutex);
-            ESP_LOGD(TAG, "Deleted timer ID: %d", (int)timer_id);
-            return UFLAKE_OK;
         }
-        prev = current;
-        current = current->next;
     }
+    ESP_LOGD(TAG, "Deleted timer ID: %d", (int)timer_id);
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_timer_set_overrun_policy(uint32_t timer_id, timer_overrun_policy_t policy)
+{
+    if (policy > TIMER_OVERRUN_REPORT)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    xSemaphoreTake(timer_mutex, portMAX_DELAY);
+
+    timer_node_t *node = timer_lookup(timer_id);
+    if (!node)
+    {
+        xSemaphoreGive(timer_mutex);
+        return UFLAKE_ERROR_NOT_FOUND;
+    }
+
+    node->timer.overrun_policy = policy;
 
     xSemaphoreGive(timer_mutex);
-    return UFLAKE_ERROR_NOT_FOUND;
+    return UFLAKE_OK;
 }
 
-void uflake_timer_process(void)
+uflake_result_t uflake_timer_get_overruns(uint32_t timer_id, uint32_t *overrun_count)
 {
-    if (!timer_mutex)
-        return;
-
-    // Use timeout to prevent deadlock
-    if (xSemaphoreTake(timer_mutex, pdMS_TO_TICKS(10)) != pdTRUE)
-        return;
+    if (!overrun_count)
+        return UFLAKE_ERROR_INVALID_PARAM;
 
-    uint32_t current_time = xTaskGetTickCount();
-    timer_node_t *node = timer_list_head;
+    xSemaphoreTake(timer_mutex, portMAX_DELAY);
 
-    while (node)
+    timer_node_t *node = timer_lookup(timer_id);
+    if (!node)
     {
-        if (node->timer.is_active && current_time >= node->timer.next_trigger)
-        {
-            // Call the timer callback
-            if (node->timer.callback)
-            {
-                node->timer.callback(node->timer.args);
-            }
-
-            if (node->timer.is_periodic)
-            {
-                node->timer.next_trigger = current_time + pdMS_TO_TICKS(node->timer.interval_ms);
-            }
-            else
-            {
-                node->timer.is_active = false;
-            }
-        }
-        node = node->next;
+        xSemaphoreGive(timer_mutex);
+        return UFLAKE_ERROR_NOT_FOUND;
     }
 
+    *overrun_count = node->timer.overrun_count;
+
+    xSemaphoreGive(timer_mutex);
+    return UFLAKE_OK;
+}
+
+uflake_result_t uflake_timer_get_stats(uflake_timer_stats_t *stats)
+{
+    if (!stats)
+        return UFLAKE_ERROR_INVALID_PARAM;
+
+    xSemaphoreTake(timer_mutex, portMAX_DELAY);
+    *stats = timer_stats;
+    stats->armed_timers = heap_count;
     xSemaphoreGive(timer_mutex);
+
+    return UFLAKE_OK;
+}
+
+void uflake_timer_process(void)
+{
+    if (timer_service_task)
+    {
+        xTaskNotifyGive(timer_service_task);
+    }
 }
@@ -76,6 +76,9 @@ uflake_result_t uflake_watchdog_create(const char *name, watchdog_type_t type,
     *watchdog_id = node->watchdog.watchdog_id;
 
     xSemaphoreGive(watchdog_mutex);
+
+    // New deadline may be earlier than the kernel's current sleep
+    uflake_kernel_notify();
     ESP_LOGI(TAG, "Created watchdog '%s' with ID: %d, timeout: %d ms", name, (int)*watchdog_id, (int)timeout_ms);
 
     return UFLAKE_OK;
@@ -169,3 +172,33 @@ uflake_result_t uflake_watchdog_delete(uint32_t watchdog_id)
     xSemaphoreGive(watchdog_mutex);
     return UFLAKE_ERROR_NOT_FOUND;
 }
+
+TickType_t uflake_watchdog_next_wakeup(void)
+{
+    if (!watchdog_mutex)
+        return portMAX_DELAY;
+
+    TickType_t wait = portMAX_DELAY;
+
+    xSemaphoreTake(watchdog_mutex, portMAX_DELAY);
+    uint32_t current_time = xTaskGetTickCount();
+    watchdog_node_t *current = watchdog_list;
+    while (current)
+    {
+        if (current->watchdog.is_active)
+        {
+            uint32_t elapsed = current_time - current->watchdog.last_feed;
+            uint32_t timeout_ticks = pdMS_TO_TICKS(current->watchdog.timeout_ms);
+
+            // Expired watchdogs were already reported - they are re-checked on the idle wakeup
+            if (elapsed < timeout_ticks && (timeout_ticks - elapsed) < wait)
+            {
+                wait = timeout_ticks - elapsed;
+            }
+        }
+        current = current->next;
+    }
+    xSemaphoreGive(watchdog_mutex);
+
+    return wait;
+}
@@ -135,7 +135,7 @@ uflake_result_t ugui_appwindow_init(void)
     memset(&g_appwin_mgr, 0, sizeof(appwindow_manager_t));
 
     // Create mutex
-    if (uflake_mutex_create(&g_appwin_mgr.mutex) != UFLAKE_OK)
+    if (uflake_mutex_create_named(&g_appwin_mgr.mutex, "gui_appwin") != UFLAKE_OK)
     {
         UFLAKE_LOGE(TAG, "Failed to create app window mutex");
         return UFLAKE_ERROR;
@@ -78,7 +78,7 @@ uflake_result_t ugui_focus_init(void) {
     memset(&g_focus_mgr, 0, sizeof(focus_manager_t));
 
     // Create mutex for thread safety
-    if (uflake_mutex_create(&g_focus_mgr.mutex) != UFLAKE_OK) {
+    if (uflake_mutex_create_named(&g_focus_mgr.mutex, "gui_focus") != UFLAKE_OK) {
         UFLAKE_LOGE(TAG, "Failed to create focus mutex");
         return UFLAKE_ERROR;
     }
@@ -42,7 +42,7 @@ uflake_result_t ugui_navigation_init(void)
     memset(&g_nav, 0, sizeof(navigation_t));
 
     // Create mutex
-    if (uflake_mutex_create(&g_nav.mutex) != UFLAKE_OK)
+    if (uflake_mutex_create_named(&g_nav.mutex, "gui_nav") != UFLAKE_OK)
     {
         UFLAKE_LOGE(TAG, "Failed to create navigation mutex");
         return UFLAKE_ERROR;
@@ -192,7 +192,7 @@ uflake_result_t ugui_notification_init(void)
     memset(&g_notif, 0, sizeof(notification_bar_t));
 
     // Create mutex
-    if (uflake_mutex_create(&g_notif.mutex) != UFLAKE_OK)
+    if (uflake_mutex_create_named(&g_notif.mutex, "gui_notif") != UFLAKE_OK)
     {
         UFLAKE_LOGE(TAG, "Failed to create notification mutex");
         return UFLAKE_ERROR;
@@ -506,8 +506,9 @@ uflake_result_t ugui_notification_show_app_name(const char *app_name, uint32_t d
             uflake_timer_delete(g_notif.app_name_timer_id);
         }
 
-        uflake_timer_create(&g_notif.app_name_timer_id, duration_ms,
-                            app_name_timer_cb, NULL, false);
+        // Hiding the app name can ride along with another wakeup
+        uflake_timer_create_ex(&g_notif.app_name_timer_id, (uint64_t)duration_ms * 1000, 100 * 1000,
+                               app_name_timer_cb, NULL, false);
         uflake_timer_start(g_notif.app_name_timer_id);
     }
 
@@ -563,8 +564,8 @@ uflake_result_t ugui_notification_show_loading(bool show)
         // Start loading animation
         if (g_notif.loading_timer_id == 0)
         {
-            uflake_timer_create(&g_notif.loading_timer_id, 100,
-                                loading_anim_timer_cb, NULL, true);
+            uflake_timer_create_ex(&g_notif.loading_timer_id, 100 * 1000, 20 * 1000,
+                                   loading_anim_timer_cb, NULL, true);
             uflake_timer_start(g_notif.loading_timer_id);
         }
         g_notif.loading_dot_count = 0;
@@ -176,7 +176,7 @@ uflake_result_t ugui_theme_init(void)
     memset(&g_theme_mgr, 0, sizeof(theme_manager_t));
 
     // Create mutex
-    if (uflake_mutex_create(&g_theme_mgr.mutex) != UFLAKE_OK)
+    if (uflake_mutex_create_named(&g_theme_mgr.mutex, "gui_theme") != UFLAKE_OK)
     {
         UFLAKE_LOGE(TAG, "Failed to create theme mutex");
         return UFLAKE_ERROR;
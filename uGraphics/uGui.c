@@ -40,8 +40,8 @@ static void lv_tick_timer_cb(void *arg)
     lv_tick_inc(LV_TICK_PERIOD_MS);
 }
 
-// Simple LVGL flush callback - matches original ST7789_write_pixels pattern
-static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+// Simple LVGL flush - matches original ST7789_write_pixels pattern
+static void lvgl_flush_area(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
 {
     driver = (st7789_driver_t *)lv_display_get_user_data(disp);
 
@@ -111,6 +111,16 @@ static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px
     lv_display_flush_ready(disp);
 }
 
+// LVGL flush callback, traced as one slice per flushed area
+static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    uint32_t pixels = (uint32_t)lv_area_get_size(area);
+
+    uflake_kernel_trace_record(KERNEL_TRACE_FLUSH_BEGIN, "lvgl_flush", pixels);
+    lvgl_flush_area(disp, area, px_map);
+    uflake_kernel_trace_record(KERNEL_TRACE_FLUSH_END, "lvgl_flush", pixels);
+}
+
 void uGui_init(st7789_driver_t *drv)
 {
     if (g_ugui_initialized)
@@ -193,7 +203,7 @@ void uGui_init(st7789_driver_t *drv)
     UFLAKE_LOGI(TAG, "LVGL display configured as 320x240 landscape with double buffering");
 
     // Create mutex using kernel for LVGL thread safety
-    if (uflake_mutex_create(&gui_mutex) != UFLAKE_OK)
+    if (uflake_mutex_create_named(&gui_mutex, "gui") != UFLAKE_OK)
     {
         UFLAKE_LOGE(TAG, "Failed to create GUI mutex");
         return;
@@ -221,12 +231,14 @@ void uGui_init(st7789_driver_t *drv)
 
     // Create GUI task using kernel process manager
     uint32_t gui_pid;
-    if (uflake_process_create("GUI_Task",
-                              gui_task,
-                              NULL,
-                              1024 * 8,
-                              PROCESS_PRIORITY_NORMAL, // Lower than kernel priority
-                              &gui_pid) != UFLAKE_OK)
+    // Pinned to core 1 so AUTO-placed CPU-heavy processes land on core 0
+    if (uflake_process_create_ex("GUI_Task",
+                                 gui_task,
+                                 NULL,
+                                 1024 * 8,
+                                 PROCESS_PRIORITY_NORMAL, // Lower than kernel priority
+                                 PROCESS_AFFINITY_CORE1,
+                                 &gui_pid) != UFLAKE_OK)
     {
         UFLAKE_LOGE(TAG, "Failed to create GUI task");
         return;
@@ -275,6 +275,78 @@ static bool decode_png(const img_reader_t *r,
  *  IMAGE TRANSFORMS (Software)
  * ========================================================================== */
 
+/* Rows per job when transforms are split across both cores */
+#define IMG_TRANSFORM_ROWS_PER_JOB 16
+
+typedef struct
+{
+    const img_rgb565_t *src;
+    uint8_t *dst;
+    uint16_t new_w;
+    uint16_t new_h;
+    img_rotate_t rot;
+} img_transform_ctx_t;
+
+static void resize_rows(uint32_t row_begin, uint32_t row_end, void *arg)
+{
+    const img_transform_ctx_t *ctx = (const img_transform_ctx_t *)arg;
+    const img_rgb565_t *img = ctx->src;
+    uint16_t src_w = img->width;
+    uint16_t src_h = img->height;
+
+    /* Nearest neighbor resize */
+    for (uint32_t y = row_begin; y < row_end; y++)
+    {
+        uint16_t src_y = (y * src_h) / ctx->new_h;
+        for (uint16_t x = 0; x < ctx->new_w; x++)
+        {
+            uint16_t src_x = (x * src_w) / ctx->new_w;
+
+            uint16_t *s = (uint16_t *)(img->pixels +
+                                       (src_y * img->stride) + src_x * 2);
+            uint16_t *d = (uint16_t *)(ctx->dst + (y * ctx->new_w + x) * 2);
+            *d = *s;
+        }
+    }
+}
+
+static void rotate_rows(uint32_t row_begin, uint32_t row_end, void *arg)
+{
+    const img_transform_ctx_t *ctx = (const img_transform_ctx_t *)arg;
+    const img_rgb565_t *img = ctx->src;
+
+    for (uint32_t y = row_begin; y < row_end; y++)
+    {
+        for (uint16_t x = 0; x < img->width; x++)
+        {
+            uint16_t *src = (uint16_t *)(img->pixels +
+                                         y * img->stride + x * 2);
+            uint16_t dx = 0, dy = 0;
+
+            switch (ctx->rot)
+            {
+            case IMG_ROTATE_90:
+                dx = img->height - 1 - y;
+                dy = x;
+                break;
+            case IMG_ROTATE_180:
+                dx = img->width - 1 - x;
+                dy = img->height - 1 - y;
+                break;
+            case IMG_ROTATE_270:
+                dx = y;
+                dy = img->width - 1 - x;
+                break;
+            default:
+                break;
+            }
+
+            uint16_t *dstp = (uint16_t *)(ctx->dst + (dy * ctx->new_w + dx) * 2);
+            *dstp = *src;
+        }
+    }
+}
+
 static bool resize_rgb565(img_rgb565_t *img, uint16_t new_w, uint16_t new_h)
 {
     if (img->width == new_w && img->height == new_h)
@@ -291,23 +363,9 @@ static bool resize_rgb565(img_rgb565_t *img, uint16_t new_w, uint16_t new_h)
         return false;
     }
 
-    uint16_t src_w = img->width;
-    uint16_t src_h = img->height;
-
-    /* Nearest neighbor resize */
-    for (uint16_t y = 0; y < new_h; y++)
-    {
-        uint16_t src_y = (y * src_h) / new_h;
-        for (uint16_t x = 0; x < new_w; x++)
-        {
-            uint16_t src_x = (x * src_w) / new_w;
-
-            uint16_t *s = (uint16_t *)(img->pixels +
-                                       (src_y * img->stride) + src_x * 2);
-            uint16_t *d = (uint16_t *)(dst + (y * new_w + x) * 2);
-            *d = *s;
-        }
-    }
+    /* Destination rows are independent - split them across both cores */
+    img_transform_ctx_t ctx = {.src = img, .dst = dst, .new_w = new_w, .new_h = new_h};
+    uflake_job_parallel_for(0, new_h, IMG_TRANSFORM_ROWS_PER_JOB, resize_rows, &ctx);
 
     free(img->pixels);
     img->pixels = dst;
@@ -344,36 +402,9 @@ static bool rotate_rgb565_sw(img_rgb565_t *img, img_rotate_t rot)
         return false;
     }
 
-    for (uint16_t y = 0; y < img->height; y++)
-    {
-        for (uint16_t x = 0; x < img->width; x++)
-        {
-            uint16_t *src = (uint16_t *)(img->pixels +
-                                         y * img->stride + x * 2);
-            uint16_t dx = 0, dy = 0;
-
-            switch (rot)
-            {
-            case IMG_ROTATE_90:
-                dx = img->height - 1 - y;
-                dy = x;
-                break;
-            case IMG_ROTATE_180:
-                dx = img->width - 1 - x;
-                dy = img->height - 1 - y;
-                break;
-            case IMG_ROTATE_270:
-                dx = y;
-                dy = img->width - 1 - x;
-                break;
-            default:
-                break;
-            }
-
-            uint16_t *dstp = (uint16_t *)(dst + (dy * new_w + dx) * 2);
-            *dstp = *src;
-        }
-    }
+    /* Each source row maps to a distinct set of destination pixels */
+    img_transform_ctx_t ctx = {.src = img, .dst = dst, .new_w = new_w, .new_h = new_h, .rot = rot};
+    uflake_job_parallel_for(0, img->height, IMG_TRANSFORM_ROWS_PER_JOB, rotate_rows, &ctx);
 
     free(img->pixels);
     img->pixels = dst;